@@ -0,0 +1,74 @@
+/* Background frame-time benchmark: the old per-frame rescale of two full-screen
+   tiles versus the repeat-pattern ScrollingBackground layer.
+
+   Usage: bench_background [background.png] [frames]
+   Renders into an offscreen 800x600 image surface, no display needed. */
+#include <gdk/gdk.h>
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "background.h"
+
+#define BENCH_WIDTH 800
+#define BENCH_HEIGHT 600
+#define WARMUP_FRAMES 30
+
+// The pre-layer draw path: rescale + convert the pixbuf twice per frame
+static void draw_legacy(cairo_t *cr, GdkPixbuf *image, gdouble scroll) {
+    gdouble y = fmod(scroll, (gdouble)BENCH_HEIGHT);
+    if (y < 0) y += BENCH_HEIGHT;
+    gdouble ys[2] = {y - BENCH_HEIGHT, y};
+    for (gint i = 0; i < 2; i++) {
+        GdkPixbuf *scaled = gdk_pixbuf_scale_simple(image, BENCH_WIDTH, BENCH_HEIGHT, GDK_INTERP_BILINEAR);
+        gdk_cairo_set_source_pixbuf(cr, scaled, 0, (gint)ys[i]);
+        cairo_paint(cr);
+        g_object_unref(scaled);
+    }
+}
+
+int main(int argc, char **argv) {
+    const gchar *path = argc > 1 ? argv[1] : "../assets/background-1.png";
+    gint frames = argc > 2 ? atoi(argv[2]) : 300;
+    if (frames <= 0) frames = 300;
+
+    GError *error = NULL;
+    GdkPixbuf *image = gdk_pixbuf_new_from_file(path, &error);
+    if (!image) {
+        g_printerr("Failed to load %s: %s\n", path, error ? error->message : "unknown");
+        if (error) g_error_free(error);
+        return 1;
+    }
+
+    cairo_surface_t *target = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, BENCH_WIDTH, BENCH_HEIGHT);
+    cairo_t *cr = cairo_create(target);
+
+    // Old path
+    gdouble scroll = 0.0;
+    for (gint i = 0; i < WARMUP_FRAMES; i++) draw_legacy(cr, image, scroll += 2.5);
+    gint64 start = g_get_monotonic_time();
+    for (gint i = 0; i < frames; i++) draw_legacy(cr, image, scroll += 2.5);
+    cairo_surface_flush(target);
+    gdouble legacy_ms = (g_get_monotonic_time() - start) / 1000.0 / frames;
+
+    // New path
+    ScrollingBackground *background = background_new(BENCH_WIDTH, BENCH_HEIGHT);
+    background_add_layer(background, image, 1.0);
+    scroll = 0.0;
+    for (gint i = 0; i < WARMUP_FRAMES; i++) background_draw(background, cr, scroll += 2.5);
+    start = g_get_monotonic_time();
+    for (gint i = 0; i < frames; i++) background_draw(background, cr, scroll += 2.5);
+    cairo_surface_flush(target);
+    gdouble layer_ms = (g_get_monotonic_time() - start) / 1000.0 / frames;
+
+    g_print("background: %d frames at %dx%d\n", frames, BENCH_WIDTH, BENCH_HEIGHT);
+    g_print("  rescale x2 per frame : %8.3f ms/frame\n", legacy_ms);
+    g_print("  repeat-pattern layer : %8.3f ms/frame\n", layer_ms);
+    g_print("  speedup              : %8.2fx\n", layer_ms > 0 ? legacy_ms / layer_ms : 0.0);
+
+    background_free(background);
+    cairo_destroy(cr);
+    cairo_surface_destroy(target);
+    g_object_unref(image);
+    return 0;
+}
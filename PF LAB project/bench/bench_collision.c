@@ -0,0 +1,212 @@
+/* Collision benchmarks:
+   1. Differential check: every batched kernel must produce bit-identical
+      results to check_collision on random (including degenerate) boxes.
+   2. Kernel microbenchmark: scalar check_collision loop vs batched kernels.
+   3. Collision cost against entity count: brute-force check_collision over
+      every obstacle versus the uniform-grid broad phase.
+
+   Usage: bench_collision [iterations] */
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "sim.h"
+#include "obstacle.h"
+#include "collision.h"
+
+#define CAR_W (50 * 1.35)
+#define CAR_H (60 * 1.35)
+
+static const guint entity_counts[] = {8, 64, 256, 1024, 4096, 16384};
+
+static gdouble rand_range(gdouble lo, gdouble hi) {
+    return lo + (hi - lo) * (rand() / (gdouble)RAND_MAX);
+}
+
+static gint brute_force(const ObstaclePool *pool, gdouble px, gdouble py) {
+    for (guint i = 0; i < pool->count; i++) {
+        if (check_collision(px, py, CAR_W, CAR_H, pool->x[i], pool->y[i], pool->w[i], pool->h[i])) {
+            return (gint)i;
+        }
+    }
+    return -1;
+}
+
+static gint broad_phase(ObstacleManager *manager, gdouble px, gdouble py) {
+    const ObstaclePool *pool = &manager->pool;
+    const guint *candidates = NULL;
+    guint n = obstacle_manager_query_rect(manager, px, py, CAR_W, CAR_H, &candidates);
+    for (guint k = 0; k < n; k++) {
+        guint i = candidates[k];
+        if (check_collision(px, py, CAR_W, CAR_H, pool->x[i], pool->y[i], pool->w[i], pool->h[i])) {
+            return (gint)i;
+        }
+    }
+    return -1;
+}
+
+static const CollisionKernel kernels[] = {COLLISION_KERNEL_SCALAR, COLLISION_KERNEL_SSE2, COLLISION_KERNEL_AVX2};
+
+/* Mostly ordinary boxes, plus zero, negative and NaN sizes/positions */
+static gdouble random_coord(void) {
+    switch (rand() % 24) {
+        case 0: return 0.0;
+        case 1: return -rand_range(0, 50);
+        case 2: return NAN;
+        default: return rand_range(-150, 450);
+    }
+}
+
+static gdouble random_size(void) {
+    switch (rand() % 24) {
+        case 0: return 0.0;
+        case 1: return -rand_range(0, 50);
+        case 2: return NAN;
+        default: return rand_range(1, 120);
+    }
+}
+
+static gboolean differential_check(guint rounds) {
+    enum { MAX_BOXES = 200 };
+    gdouble x[MAX_BOXES], y[MAX_BOXES], w[MAX_BOXES], h[MAX_BOXES];
+    guint64 mask[(MAX_BOXES + 63) / 64];
+    guint64 compared = 0;
+
+    for (guint round = 0; round < rounds; round++) {
+        guint count = rand() % MAX_BOXES;
+        for (guint i = 0; i < count; i++) {
+            x[i] = random_coord();
+            y[i] = random_coord();
+            w[i] = random_size();
+            h[i] = random_size();
+        }
+        gdouble px = random_coord(), py = random_coord();
+        gdouble pw = round % 8 ? CAR_W : random_size();
+        gdouble ph = round % 8 ? CAR_H : random_size();
+
+        CollisionBox box;
+        collision_box_init(&box, px, py, pw, ph);
+        gint expected_first = -1;
+        for (guint i = 0; i < count && expected_first < 0; i++) {
+            if (check_collision(px, py, pw, ph, x[i], y[i], w[i], h[i])) expected_first = (gint)i;
+        }
+
+        for (guint k = 0; k < G_N_ELEMENTS(kernels); k++) {
+            if (!collision_set_kernel(kernels[k])) continue;
+            collision_hit_mask(&box, x, y, w, h, count, mask);
+            for (guint i = 0; i < count; i++) {
+                gboolean expected = check_collision(px, py, pw, ph, x[i], y[i], w[i], h[i]);
+                gboolean got = (mask[i / 64] >> (i % 64)) & 1;
+                if (expected != got) {
+                    g_printerr("MISMATCH (%s) round %u box %u\n", collision_kernel_name(kernels[k]), round, i);
+                    return FALSE;
+                }
+                compared++;
+            }
+            if (collision_first_hit(&box, x, y, w, h, count) != expected_first) {
+                g_printerr("MISMATCH (%s) first hit, round %u\n", collision_kernel_name(kernels[k]), round);
+                return FALSE;
+            }
+        }
+    }
+    collision_set_kernel(COLLISION_KERNEL_AUTO);
+    g_print("differential check: %" G_GUINT64_FORMAT " box tests identical across kernels\n\n", compared);
+    return TRUE;
+}
+
+/* Full sweep of count boxes (no early exit) so every kernel does the same work */
+static void kernel_microbench(gint iterations) {
+    enum { COUNT = 1024 };
+    gdouble *x = g_new(gdouble, COUNT), *y = g_new(gdouble, COUNT);
+    gdouble *w = g_new(gdouble, COUNT), *h = g_new(gdouble, COUNT);
+    guint64 mask[COUNT / 64];
+    for (guint i = 0; i < COUNT; i++) {
+        w[i] = rand_range(30, 95);
+        h[i] = rand_range(30, 70);
+        x[i] = rand_range(0, GAME_WIDTH - w[i]);
+        y[i] = rand_range(-h[i], GAME_HEIGHT);
+    }
+    CollisionBox box;
+    collision_box_init(&box, 366, 500, CAR_W, CAR_H);
+
+    guint sink = 0;
+    gint64 start = g_get_monotonic_time();
+    for (gint it = 0; it < iterations; it++) {
+        for (guint i = 0; i < COUNT; i++) {
+            sink += check_collision(box.x, box.y, box.w, box.h, x[i], y[i], w[i], h[i]);
+        }
+    }
+    gdouble scalar_ns = (g_get_monotonic_time() - start) * 1000.0 / ((gdouble)iterations * COUNT);
+    g_print("%-24s %8.3f ns/box\n", "check_collision loop", scalar_ns);
+
+    for (guint k = 0; k < G_N_ELEMENTS(kernels); k++) {
+        if (!collision_set_kernel(kernels[k])) continue;
+        start = g_get_monotonic_time();
+        for (gint it = 0; it < iterations; it++) {
+            collision_hit_mask(&box, x, y, w, h, COUNT, mask);
+            sink += (guint)mask[0];
+        }
+        gdouble ns = (g_get_monotonic_time() - start) * 1000.0 / ((gdouble)iterations * COUNT);
+        g_print("%-24s %8.3f ns/box  (%.2fx)\n", collision_kernel_name(kernels[k]), ns, ns > 0 ? scalar_ns / ns : 0.0);
+    }
+    collision_set_kernel(COLLISION_KERNEL_AUTO);
+    g_print("(sink %u)\n\n", sink);
+
+    g_free(x);
+    g_free(y);
+    g_free(w);
+    g_free(h);
+}
+
+int main(int argc, char **argv) {
+    gint iterations = argc > 1 ? atoi(argv[1]) : 2000;
+    if (iterations <= 0) iterations = 2000;
+    srand(1);
+
+    if (!differential_check(20000)) return 1;
+    kernel_microbench(iterations);
+
+    g_print("%8s %14s %14s %10s\n", "entities", "brute us/tick", "grid us/tick", "speedup");
+    for (guint n = 0; n < G_N_ELEMENTS(entity_counts); n++) {
+        guint count = entity_counts[n];
+        ObstacleManager *manager = obstacle_manager_new();
+        for (guint i = 0; i < count; i++) {
+            gdouble size = 30 + rand() % 3 * 15;
+            obstacle_manager_add(manager, rand_range(0, GAME_WIDTH - size), rand_range(-size, GAME_HEIGHT - size),
+                                 size * 1.35, size * 1.35, 0.0, -1);
+        }
+
+        /* Same player positions for both passes; hit/miss answers must agree */
+        gdouble *px = g_new(gdouble, iterations);
+        gdouble *py = g_new(gdouble, iterations);
+        for (gint i = 0; i < iterations; i++) {
+            px[i] = rand_range(0, GAME_WIDTH - CAR_W);
+            py[i] = rand_range(0, GAME_HEIGHT - CAR_H);
+        }
+
+        gint hits_brute = 0, hits_grid = 0;
+        gint64 start = g_get_monotonic_time();
+        for (gint i = 0; i < iterations; i++) {
+            hits_brute += brute_force(&manager->pool, px[i], py[i]) >= 0;
+        }
+        gdouble brute_us = (g_get_monotonic_time() - start) / (gdouble)iterations;
+
+        start = g_get_monotonic_time();
+        for (gint i = 0; i < iterations; i++) {
+            obstacle_manager_update(manager, 0.0, GAME_HEIGHT); /* dirties the grid: the query below rebuilds it */
+            hits_grid += broad_phase(manager, px[i], py[i]) >= 0;
+        }
+        gdouble grid_us = (g_get_monotonic_time() - start) / (gdouble)iterations;
+
+        if (hits_brute != hits_grid) {
+            g_printerr("MISMATCH at %u entities: brute=%d grid=%d\n", count, hits_brute, hits_grid);
+            return 1;
+        }
+        g_print("%8u %14.3f %14.3f %9.2fx\n", count, brute_us, grid_us, grid_us > 0 ? brute_us / grid_us : 0.0);
+
+        g_free(px);
+        g_free(py);
+        obstacle_manager_free(manager);
+    }
+    return 0;
+}
@@ -0,0 +1,202 @@
+/* Difficulty table check and per-tick cost, headless (libcarsim.a only).
+
+   1. Tolerance: difficulty_table_lookup against the original per-point
+      formulas (copied below as they were in sim.c) and against
+      difficulty_evaluate, for every score up to MAX_CHECK_SCORE, for the
+      built-in curve and every group of an optional params.ini.
+   2. Progression: 30 minutes of score accrual at 60 Hz with the old
+      per-point update loop and with the per-tick table lookup; score and
+      multipliers must agree on every tick.
+   3. Cost: ns per tick of both update strategies over that progression.
+   Exits nonzero if any check exceeds DIFFICULTY_TOLERANCE.
+
+   Usage: bench_difficulty [params.ini]   (e.g. ../bench/difficulty_params.ini) */
+#include <glib.h>
+#include <math.h>
+#include <stdio.h>
+#include "sim.h"
+#include "difficulty.h"
+
+#define BENCH_TICK (1.0 / 60.0)
+#define PROGRESSION_TICKS (60 * 60 * 30)
+#define MAX_CHECK_SCORE 100000
+#define DIFFICULTY_TOLERANCE 1e-12  // relative; the table stores the formula's own results, so expect 0
+#define SCORE_RATE_BASE (60.0 * SPEEDUP_FACTOR)
+#define TIMING_ROUNDS 20
+
+static volatile gdouble sink;
+
+/* The per-point update sim.c ran before the table, verbatim apart from
+   writing into a DifficultyLevel */
+static void legacy_update_difficulty(const DifficultyParams *params, gint score, DifficultyLevel *out) {
+    gdouble score_norm = (gdouble)score;
+    gdouble speed_factor = 1.0 + (score_norm / params->k_speed);
+    out->speed_multiplier = pow(speed_factor, 1.5);
+    if (out->speed_multiplier > params->max_speed_mult) {
+        out->speed_multiplier = params->max_speed_mult;
+    }
+    gdouble spawn_factor = 1.0 + (score_norm / params->k_spawn);
+    out->spawn_multiplier = 1.0 / pow(spawn_factor, 1.2);
+    if (out->spawn_multiplier < (params->min_spawn_interval / DIFFICULTY_BASE_SPAWN_INTERVAL)) {
+        out->spawn_multiplier = params->min_spawn_interval / DIFFICULTY_BASE_SPAWN_INTERVAL;
+    }
+    gdouble mult_factor = 1.0 + pow(score_norm / 3000.0, 0.8);
+    if (mult_factor > 4.0) mult_factor = 4.0;
+    out->score_multiplier = mult_factor;
+    gint stage = 1;
+    while (stage < DIFFICULTY_STAGE_COUNT && score_norm >= params->stage_max[stage - 1]) {
+        stage++;
+    }
+    out->stage = stage;
+}
+
+// The legacy formulas hard-code the curve shape; only sets that keep it can be compared with them
+static gboolean uses_legacy_shape(const DifficultyParams *params) {
+    return params->speed_exponent == 1.5 && params->spawn_exponent == 1.2 && params->score_scale == 3000.0 &&
+           params->score_exponent == 0.8 && params->max_score_mult == 4.0;
+}
+
+static gdouble relative_error(gdouble a, gdouble b) {
+    gdouble scale = MAX(fabs(a), fabs(b));
+    return scale > 0.0 ? fabs(a - b) / scale : 0.0;
+}
+
+static gdouble level_error(const DifficultyLevel *a, const DifficultyLevel *b) {
+    if (a->stage != b->stage) return INFINITY;
+    gdouble e = relative_error(a->speed_multiplier, b->speed_multiplier);
+    e = MAX(e, relative_error(a->spawn_multiplier, b->spawn_multiplier));
+    return MAX(e, relative_error(a->score_multiplier, b->score_multiplier));
+}
+
+static gboolean check_table(const gchar *name, const DifficultyParams *params) {
+    DifficultyTable *table = difficulty_table_new(params);
+    gboolean legacy = uses_legacy_shape(params);
+    gdouble max_formula = 0.0, max_legacy = 0.0;
+    for (gint score = 0; score <= MAX_CHECK_SCORE; score++) {
+        DifficultyLevel looked_up, evaluated, old;
+        difficulty_table_lookup(table, score, &looked_up);
+        difficulty_evaluate(params, score, &evaluated);
+        max_formula = MAX(max_formula, level_error(&looked_up, &evaluated));
+        if (legacy) {
+            legacy_update_difficulty(params, score, &old);
+            max_legacy = MAX(max_legacy, level_error(&looked_up, &old));
+        }
+    }
+    gboolean ok = max_formula <= DIFFICULTY_TOLERANCE && max_legacy <= DIFFICULTY_TOLERANCE;
+    gsize bytes = (table->speed.length + table->spawn.length + table->score.length) * sizeof(gdouble);
+    g_print("%-12s table %5u/%5u/%5u points (%4.0f KiB)  max rel. error vs formula %.2e",
+            name, table->speed.length, table->spawn.length, table->score.length, bytes / 1024.0, max_formula);
+    if (legacy) g_print(", vs legacy %.2e", max_legacy);
+    g_print("  %s\n", ok ? "ok" : "FAILED");
+    difficulty_table_unref(table);
+    return ok;
+}
+
+typedef struct {
+    gint score;
+    gdouble score_accum;
+    DifficultyLevel level;
+} Progress;
+
+// Old sim_step: recompute with pow() after every point gained
+static void tick_per_point(Progress *p, const DifficultyParams *params) {
+    p->score_accum += (SCORE_RATE_BASE * p->level.score_multiplier) * BENCH_TICK;
+    while (p->score_accum >= 1.0) {
+        p->score += 1;
+        p->score_accum -= 1.0;
+        legacy_update_difficulty(params, p->score, &p->level);
+    }
+}
+
+// New sim_step: all points of the tick, then one table lookup
+static void tick_per_tick(Progress *p, const DifficultyTable *table) {
+    p->score_accum += (SCORE_RATE_BASE * p->level.score_multiplier) * BENCH_TICK;
+    if (p->score_accum >= 1.0) {
+        while (p->score_accum >= 1.0) {
+            p->score += 1;
+            p->score_accum -= 1.0;
+        }
+        difficulty_table_lookup(table, p->score, &p->level);
+    }
+}
+
+static void progress_start(Progress *p, const DifficultyParams *params) {
+    p->score = 0;
+    p->score_accum = 0.0;
+    difficulty_evaluate(params, 0, &p->level);
+}
+
+static gboolean check_progression(const DifficultyParams *params, const DifficultyTable *table) {
+    Progress old, new;
+    progress_start(&old, params);
+    progress_start(&new, params);
+    for (guint t = 0; t < PROGRESSION_TICKS; t++) {
+        tick_per_point(&old, params);
+        tick_per_tick(&new, table);
+        if (old.score != new.score || old.score_accum != new.score_accum || level_error(&old.level, &new.level) > DIFFICULTY_TOLERANCE) {
+            g_print("progression  diverged at tick %u: score %d vs %d  FAILED\n", t, old.score, new.score);
+            return FALSE;
+        }
+    }
+    g_print("progression  %u ticks, final score %d, identical every tick  ok\n", PROGRESSION_TICKS, new.score);
+    return TRUE;
+}
+
+static void time_updates(const DifficultyParams *params, const DifficultyTable *table) {
+    gint64 per_point_us = 0, per_tick_us = 0;
+    for (guint round = 0; round < TIMING_ROUNDS; round++) {
+        Progress p;
+        progress_start(&p, params);
+        gint64 start = g_get_monotonic_time();
+        for (guint t = 0; t < PROGRESSION_TICKS; t++) tick_per_point(&p, params);
+        per_point_us += g_get_monotonic_time() - start;
+        sink += p.level.speed_multiplier;
+
+        progress_start(&p, params);
+        start = g_get_monotonic_time();
+        for (guint t = 0; t < PROGRESSION_TICKS; t++) tick_per_tick(&p, table);
+        per_tick_us += g_get_monotonic_time() - start;
+        sink += p.level.speed_multiplier;
+    }
+    gdouble ticks = (gdouble)PROGRESSION_TICKS * TIMING_ROUNDS;
+    g_print("cost         per-point pow(): %.1f ns/tick   per-tick table: %.1f ns/tick   (%.1fx)\n",
+            per_point_us * 1000.0 / ticks, per_tick_us * 1000.0 / ticks,
+            per_tick_us > 0 ? (gdouble)per_point_us / per_tick_us : 0.0);
+}
+
+int main(int argc, char **argv) {
+    gboolean ok = TRUE;
+    DifficultyParams defaults;
+    difficulty_params_defaults(&defaults);
+    ok &= check_table("default", &defaults);
+
+    if (argc > 1) {
+        GKeyFile *file = g_key_file_new();
+        GError *error = NULL;
+        if (!g_key_file_load_from_file(file, argv[1], G_KEY_FILE_NONE, &error)) {
+            g_printerr("Cannot read %s: %s\n", argv[1], error->message);
+            g_error_free(error);
+            g_key_file_free(file);
+            return 1;
+        }
+        gchar **groups = g_key_file_get_groups(file, NULL);
+        for (guint g = 0; groups[g]; g++) {
+            DifficultyParams params;
+            difficulty_params_defaults(&params);
+            if (!difficulty_params_load(&params, file, groups[g], &error)) {
+                g_printerr("%s, skipped\n", error->message);
+                g_clear_error(&error);
+                continue;
+            }
+            ok &= check_table(groups[g], &params);
+        }
+        g_strfreev(groups);
+        g_key_file_free(file);
+    }
+
+    DifficultyTable *table = difficulty_table_new(&defaults);
+    ok &= check_progression(&defaults, table);
+    time_updates(&defaults, table);
+    difficulty_table_unref(table);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include "bench_harness.h"
+#include "compare.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_ITERATIONS (G_GUINT64_CONSTANT(1) << 40)
+
+void bench_config_defaults(BenchConfig *config) {
+    config->warmup_ms = 200;
+    config->samples = 30;
+    config->min_sample_us = 5000;
+    config->filter = NULL;
+    config->label = NULL;
+}
+
+// Handle one of the shared --warmup-ms=, --samples=, --min-sample-us=, --filter=, --label= options
+gboolean bench_config_parse_option(BenchConfig *config, const gchar *arg) {
+    if (g_str_has_prefix(arg, "--warmup-ms=")) {
+        config->warmup_ms = (guint)atoi(arg + strlen("--warmup-ms="));
+    } else if (g_str_has_prefix(arg, "--samples=")) {
+        config->samples = MAX(1, atoi(arg + strlen("--samples=")));
+    } else if (g_str_has_prefix(arg, "--min-sample-us=")) {
+        config->min_sample_us = MAX(1, atoi(arg + strlen("--min-sample-us=")));
+    } else if (g_str_has_prefix(arg, "--filter=")) {
+        config->filter = arg + strlen("--filter=");
+    } else if (g_str_has_prefix(arg, "--label=")) {
+        config->label = arg + strlen("--label=");
+    } else {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+BenchReport* bench_report_new(const gchar *suite, const BenchConfig *config) {
+    BenchReport *report = g_malloc0(sizeof(BenchReport));
+    report->config = *config;
+    report->suite = g_strdup(suite);
+    report->results = g_ptr_array_new();
+    return report;
+}
+
+// Wall time of one sample: setup (untimed), then the body
+static gint64 time_sample(BenchFunc func, BenchSetupFunc setup, gpointer data, guint64 iterations) {
+    if (setup) setup(data);
+    gint64 start = g_get_monotonic_time();
+    func(data, iterations);
+    return g_get_monotonic_time() - start;
+}
+
+/* Calibrate, warm up and sample one benchmark, then print a summary line.
+   Returns FALSE when the benchmark was skipped by the filter. */
+gboolean bench_report_run(BenchReport *report, const gchar *name, const gchar *params,
+                          BenchFunc func, BenchSetupFunc setup, gpointer data) {
+    const BenchConfig *config = &report->config;
+    if (config->filter && !strstr(name, config->filter)) return FALSE;
+
+    /* Grow the batch until a sample is long enough for the clock to resolve */
+    guint64 iterations = 1;
+    while (time_sample(func, setup, data, iterations) < config->min_sample_us && iterations < BENCH_MAX_ITERATIONS) {
+        iterations *= 2;
+    }
+
+    gint64 warmup_end = g_get_monotonic_time() + (gint64)config->warmup_ms * 1000;
+    while (g_get_monotonic_time() < warmup_end) {
+        time_sample(func, setup, data, iterations);
+    }
+
+    gdouble *ns = g_new(gdouble, config->samples);
+    gdouble sum = 0.0;
+    for (guint s = 0; s < config->samples; s++) {
+        ns[s] = time_sample(func, setup, data, iterations) * 1000.0 / iterations;
+        sum += ns[s];
+    }
+    qsort(ns, config->samples, sizeof(gdouble), compare_doubles);
+
+    BenchResult *result = g_malloc0(sizeof(BenchResult));
+    result->name = g_strdup(name);
+    result->params = g_strdup(params ? params : "{}");
+    result->iterations = iterations;
+    result->samples = config->samples;
+    result->mean_ns = sum / config->samples;
+    for (guint s = 0; s < config->samples; s++) {
+        result->stddev_ns += (ns[s] - result->mean_ns) * (ns[s] - result->mean_ns);
+    }
+    result->stddev_ns = sqrt(result->stddev_ns / config->samples);
+    result->min_ns = ns[0];
+    result->max_ns = ns[config->samples - 1];
+    result->median_ns = config->samples % 2 ? ns[config->samples / 2]
+                                            : (ns[config->samples / 2 - 1] + ns[config->samples / 2]) / 2.0;
+    result->p95_ns = ns[MIN(config->samples - 1, (guint)ceil(0.95 * config->samples) - 1)];
+    g_free(ns);
+    g_ptr_array_add(report->results, result);
+
+    g_print("%-28s %-22s %12.1f ns  p95 %12.1f ns  +-%5.1f%%  (%" G_GUINT64_FORMAT " x %u)\n",
+            name, result->params, result->median_ns, result->p95_ns,
+            result->mean_ns > 0 ? 100.0 * result->stddev_ns / result->mean_ns : 0.0, iterations, result->samples);
+    return TRUE;
+}
+
+/* One object per run: suite, label, settings and every result. Stable keys so
+   runs of different versions can be diffed or loaded side by side. */
+gboolean bench_report_write_json(const BenchReport *report, const gchar *path, GError **error) {
+    GString *json = g_string_new("{\n");
+    g_string_append_printf(json, "  \"suite\": \"%s\",\n", report->suite);
+    gchar *label = g_strescape(report->config.label ? report->config.label : "", NULL);
+    g_string_append_printf(json, "  \"label\": \"%s\",\n", label);
+    g_free(label);
+    g_string_append_printf(json, "  \"timestamp\": %" G_GINT64_FORMAT ",\n", g_get_real_time() / G_USEC_PER_SEC);
+    g_string_append_printf(json, "  \"config\": {\"warmup_ms\": %u, \"samples\": %u, \"min_sample_us\": %u},\n",
+                           report->config.warmup_ms, report->config.samples, report->config.min_sample_us);
+    g_string_append(json, "  \"results\": [\n");
+    for (guint i = 0; i < report->results->len; i++) {
+        const BenchResult *r = g_ptr_array_index(report->results, i);
+        g_string_append_printf(json,
+                               "    {\"name\": \"%s\", \"params\": %s, \"iterations\": %" G_GUINT64_FORMAT ", \"samples\": %u, "
+                               "\"unit\": \"ns/op\", \"min\": %.2f, \"median\": %.2f, \"mean\": %.2f, \"stddev\": %.2f, "
+                               "\"p95\": %.2f, \"max\": %.2f}%s\n",
+                               r->name, r->params, r->iterations, r->samples, r->min_ns, r->median_ns, r->mean_ns,
+                               r->stddev_ns, r->p95_ns, r->max_ns, i + 1 < report->results->len ? "," : "");
+    }
+    g_string_append(json, "  ]\n}\n");
+
+    gboolean ok = g_file_set_contents(path, json->str, json->len, error);
+    g_string_free(json, TRUE);
+    return ok;
+}
+
+void bench_report_free(BenchReport *report) {
+    if (!report) return;
+    for (guint i = 0; i < report->results->len; i++) {
+        BenchResult *result = g_ptr_array_index(report->results, i);
+        g_free(result->name);
+        g_free(result->params);
+        g_free(result);
+    }
+    g_ptr_array_free(report->results, TRUE);
+    g_free(report->suite);
+    g_free(report);
+}
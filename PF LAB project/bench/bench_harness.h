@@ -0,0 +1,52 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <glib.h>
+
+/* Small benchmark harness shared by bench programs: warmup, batch size
+   calibration, repeated timed samples, summary statistics and JSON output.
+
+   A benchmark is a body run `iterations` times per sample plus an optional
+   untimed setup run before every sample (e.g. to refill a pool the body
+   drains). All statistics are per single operation, in nanoseconds. */
+
+typedef void (*BenchFunc)(gpointer data, guint64 iterations);
+typedef void (*BenchSetupFunc)(gpointer data);
+
+typedef struct {
+    guint warmup_ms;         // untimed running before the first sample
+    guint samples;           // timed samples per benchmark
+    guint min_sample_us;     // iterations per sample are doubled until a sample takes this long
+    const gchar *filter;     // run only benchmarks whose name contains this, NULL = all
+    const gchar *label;      // free-form version tag copied into the JSON (e.g. a git hash)
+} BenchConfig;
+
+typedef struct {
+    gchar *name;             // "group/benchmark"
+    gchar *params;           // JSON object text, e.g. {"entities": 64}
+    guint64 iterations;      // operations per sample
+    guint samples;
+    gdouble min_ns;
+    gdouble median_ns;
+    gdouble mean_ns;
+    gdouble stddev_ns;
+    gdouble p95_ns;
+    gdouble max_ns;
+} BenchResult;
+
+typedef struct {
+    BenchConfig config;
+    gchar *suite;
+    GPtrArray *results;      // BenchResult*, in run order
+} BenchReport;
+
+void bench_config_defaults(BenchConfig *config);
+gboolean bench_config_parse_option(BenchConfig *config, const gchar *arg);
+
+BenchReport* bench_report_new(const gchar *suite, const BenchConfig *config);
+gboolean bench_report_run(BenchReport *report, const gchar *name, const gchar *params,
+                          BenchFunc func, BenchSetupFunc setup, gpointer data);
+gboolean bench_report_write_json(const BenchReport *report, const gchar *path, GError **error);
+void bench_report_free(BenchReport *report);
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,172 @@
+/* Key event to tick assignment, headless (libcarsim.a only).
+
+   Replays a synthetic stream of steering key presses (many of them taps
+   shorter than a tick) through game_loop's frame/tick schedule twice:
+     sampled - the old path: held keys read once per frame, every tick of the
+               frame sees the same mask
+     queued  - InputQueue: each event applied to the tick it happened in
+   and reports, per display refresh rate, how many presses never reached a
+   tick, the event-to-frame latency of the rest, and how far the tick that
+   first saw a press started from the press itself (negative = the tick
+   acted before the key went down). Exits nonzero if the queue loses a press.
+
+   Usage: bench_input [seconds] */
+#include <glib.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "rng.h"
+#include "input_queue.h"
+
+#define BENCH_TICK_RATE 60.0
+#define BENCH_MAX_TICKS_PER_FRAME 8    // as game.h MAX_TICKS_PER_FRAME
+#define DEFAULT_SECONDS 600
+
+typedef struct {
+    gint64 down_us;
+    gint64 up_us;
+} Press;
+
+typedef struct {
+    const gchar *name;
+    gdouble refresh_hz;
+    gint64 jitter_us;      // frame callbacks land up to this much late
+} Display;
+
+typedef struct {
+    guint seen;
+    gdouble latency_ms_sum;
+    gdouble latency_ms_max;
+    gdouble offset_ms_sum;  // |tick start - press|
+    gdouble offset_ms_min;
+} Outcome;
+
+/* One key: gaps of 30..300 ms, 40% taps of 4..16 ms, other holds 20..250 ms */
+static Press* make_presses(guint64 seed, gint64 duration_us, guint *count) {
+    Rng rng;
+    rng_seed(&rng, seed, 3);
+    GArray *presses = g_array_new(FALSE, FALSE, sizeof(Press));
+    gint64 t = 100000;
+    while (t < duration_us) {
+        Press press;
+        press.down_us = t + 30000 + rng_range(&rng, 270000);
+        gint64 hold = rng_range(&rng, 10) < 4 ? 4000 + rng_range(&rng, 12000) : 20000 + rng_range(&rng, 230000);
+        press.up_us = press.down_us + hold;
+        g_array_append_val(presses, press);
+        t = press.up_us;
+    }
+    *count = presses->len;
+    return (Press *)g_array_free(presses, FALSE);
+}
+
+/* A tick whose mask holds the key shows the newest press that happened
+   before cutoff_us; record it the first time */
+static void note_tick(const Press *presses, guint count, guint *latest, gboolean *seen, gint64 cutoff_us,
+                      gint64 tick_start_us, gint64 frame_us, Outcome *out) {
+    while (*latest + 1 < count && presses[*latest + 1].down_us < cutoff_us) (*latest)++;
+    if (presses[*latest].down_us >= cutoff_us || seen[*latest]) return;
+    seen[*latest] = TRUE;
+    gdouble latency = (frame_us - presses[*latest].down_us) / 1000.0;
+    gdouble offset = (tick_start_us - presses[*latest].down_us) / 1000.0;
+    out->seen++;
+    out->latency_ms_sum += latency;
+    out->latency_ms_max = MAX(out->latency_ms_max, latency);
+    out->offset_ms_sum += ABS(offset);
+    out->offset_ms_min = MIN(out->offset_ms_min, offset);
+}
+
+/* game_loop's schedule: frames at the display rate, fixed ticks from an
+   accumulator, tick spans ending at span_start + k * dt */
+static void run(const Display *display, const Press *presses, guint count, gint64 duration_us, gboolean queued, Outcome *out) {
+    gint64 dt_us = (gint64)(G_USEC_PER_SEC / BENCH_TICK_RATE);
+    gdouble dt = 1.0 / BENCH_TICK_RATE;
+    gint64 frame_us = (gint64)(G_USEC_PER_SEC / display->refresh_hz);
+    Rng jitter;
+    rng_seed(&jitter, 11, 5);
+
+    InputQueue *queue = input_queue_new();
+    gboolean *seen = g_new0(gboolean, count);
+    guint next_event = 0, latest = 0;   // events are presses[i/2] down, then up
+    gboolean held = FALSE;
+    gdouble accumulator = 0.0;
+    gint64 last = 0;
+    memset(out, 0, sizeof(*out));
+    out->offset_ms_min = G_MAXDOUBLE;
+
+    for (gint64 vsync = frame_us; vsync < duration_us; vsync += frame_us) {
+        gint64 now = vsync + (display->jitter_us ? rng_range(&jitter, (guint32)display->jitter_us) : 0);
+        // The event loop delivers everything that happened before this frame
+        while (next_event < count * 2) {
+            const Press *press = &presses[next_event / 2];
+            gint64 t = (next_event & 1) ? press->up_us : press->down_us;
+            if (t > now) break;
+            if (queued) {
+                input_queue_push(queue, 0, t, SIM_INPUT_LEFT, !(next_event & 1));
+            } else {
+                held = !(next_event & 1);
+            }
+            next_event++;
+        }
+
+        accumulator += (now - last) / (gdouble)G_USEC_PER_SEC;
+        last = now;
+        gint64 span_start = now - (gint64)(accumulator * G_USEC_PER_SEC);
+        gint due = MIN((gint)(accumulator / dt), BENCH_MAX_TICKS_PER_FRAME);
+        gint ticks = 0;
+        while (accumulator >= dt && ticks < BENCH_MAX_TICKS_PER_FRAME) {
+            ticks++;
+            gint64 tick_end = ticks == due ? now : span_start + ticks * dt_us;
+            gint64 tick_start = span_start + (ticks - 1) * dt_us;
+            guint mask = queued ? input_queue_take_tick(queue, tick_end) : (held ? SIM_INPUT_LEFT : 0);
+            if (mask & SIM_INPUT_LEFT) {
+                note_tick(presses, count, &latest, seen, queued ? tick_end : now + 1, tick_start, now, out);
+            }
+            accumulator -= dt;
+        }
+        if (accumulator >= dt) accumulator = fmod(accumulator, dt);
+    }
+    g_free(seen);
+    input_queue_free(queue);
+}
+
+static gboolean report(const Display *display, const Press *presses, guint count, gint64 duration_us) {
+    Outcome sampled, queued;
+    run(display, presses, count, duration_us, FALSE, &sampled);
+    run(display, presses, count, duration_us, TRUE, &queued);
+    const Outcome *outcomes[2] = {&sampled, &queued};
+    const gchar *names[2] = {"sampled", "queued"};
+    for (guint i = 0; i < 2; i++) {
+        const Outcome *o = outcomes[i];
+        guint n = MAX(o->seen, 1);
+        g_print("%-14s %-8s presses lost %5u/%u  latency mean %5.1f ms max %5.1f ms  tick offset mean %4.1f ms min %+6.1f ms\n",
+                display->name, names[i], count - o->seen, count, o->latency_ms_sum / n, o->latency_ms_max,
+                o->offset_ms_sum / n, o->seen ? o->offset_ms_min : 0.0);
+    }
+    return queued.seen == count;
+}
+
+int main(int argc, char **argv) {
+    gint64 seconds = argc > 1 ? atoi(argv[1]) : DEFAULT_SECONDS;
+    if (seconds <= 0) seconds = DEFAULT_SECONDS;
+    gint64 duration_us = seconds * G_USEC_PER_SEC;
+
+    guint count;
+    Press *presses = make_presses(42, duration_us, &count);
+    // Presses still down at the end would never be released; stop before them
+    while (count > 0 && presses[count - 1].up_us >= duration_us - G_USEC_PER_SEC) count--;
+
+    static const Display displays[] = {
+        {"60 Hz", 60.0, 0},
+        {"60 Hz jitter", 60.0, 4000},
+        {"144 Hz", 144.0, 0},
+        {"30 Hz", 30.0, 0},
+    };
+    gboolean ok = TRUE;
+    for (guint i = 0; i < G_N_ELEMENTS(displays); i++) {
+        ok &= report(&displays[i], presses, count, duration_us);
+    }
+    g_free(presses);
+    return ok ? 0 : 1;
+}
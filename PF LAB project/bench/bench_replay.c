@@ -0,0 +1,134 @@
+/* Replay round trip and playback speed, headless (libcarsim.a only).
+
+   Without arguments: records synthetic sessions, saves them, memory-maps them
+   back and replays each through the simulation core, checking the outcome
+   matches the recording. Reports log size and playback ticks per second.
+   Exits nonzero if any replay diverges.
+
+   With a path: replays that log (e.g. one written by car_game --record=FILE)
+   and reports whether it reproduces the recorded score.
+
+   Usage: bench_replay [sessions] | bench_replay FILE.rep */
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim.h"
+#include "rng.h"
+#include "replay.h"
+
+#define BENCH_TICK_RATE 60.0
+#define MAX_SESSION_TICKS (60 * 60 * 10)
+
+/* Human-like input: a key combination held for a random 5..40 ticks,
+   occasionally switching movement mode */
+static guint8 next_input(Rng *policy, guint8 current, guint *hold) {
+    if (*hold > 0) {
+        (*hold)--;
+        return current;
+    }
+    *hold = 5 + rng_range(policy, 36);
+    guint8 input = (guint8)rng_range(policy, 16);
+    gboolean arcade = (current & REPLAY_INPUT_ARCADE) != 0;
+    if (rng_range(policy, 50) == 0) arcade = !arcade;
+    return input | (arcade ? REPLAY_INPUT_ARCADE : 0);
+}
+
+static gboolean record_session(SimContext *sim, guint64 seed, const gchar *path, guint64 *ticks, gint64 *bytes) {
+    Rng policy;
+    rng_seed(&policy, seed, 7);
+    ReplayRecorder *recorder = replay_recorder_new(seed, BENCH_TICK_RATE);
+    sim_set_seed(sim, seed);
+    sim_reset(sim);
+
+    guint8 input = 0;
+    guint hold = 0;
+    while (!sim_is_over(sim) && sim_get_tick(sim) < MAX_SESSION_TICKS) {
+        input = next_input(&policy, input, &hold);
+        replay_recorder_push(recorder, input);
+        sim_set_arcade_mode(sim, (input & REPLAY_INPUT_ARCADE) != 0);
+        sim_step(sim, input & ~REPLAY_INPUT_ARCADE, 1.0 / BENCH_TICK_RATE);
+    }
+
+    GError *error = NULL;
+    gboolean ok = replay_recorder_save(recorder, path, sim_get_score(sim),
+                                       sim_is_over(sim) ? REPLAY_FLAG_GAME_OVER : 0, &error);
+    if (!ok) {
+        g_printerr("Failed to save %s: %s\n", path, error->message);
+        g_error_free(error);
+    }
+    *ticks = recorder->tick_count;
+    *bytes = REPLAY_HEADER_SIZE + recorder->runs->len;
+    replay_recorder_free(recorder);
+    return ok;
+}
+
+static int replay_file(const gchar *path) {
+    GError *error = NULL;
+    Replay *replay = replay_open(path, &error);
+    if (!replay) {
+        g_printerr("%s\n", error->message);
+        g_error_free(error);
+        return 1;
+    }
+    SimContext *sim = sim_new();
+    gint64 start = g_get_monotonic_time();
+    gboolean same = replay_run(replay, sim);
+    gdouble seconds = (g_get_monotonic_time() - start) / (gdouble)G_USEC_PER_SEC;
+
+    g_print("%s: seed %" G_GUINT64_FORMAT ", %.0f Hz, %" G_GUINT64_FORMAT " ticks (%.1f s of play)\n",
+            path, replay->seed, replay->tick_rate, replay->tick_count, replay->tick_count / replay->tick_rate);
+    g_print("  replayed in %.4f s: score %d, recorded %d -> %s\n",
+            seconds, sim_get_score(sim), replay->final_score, same ? "identical" : "DIVERGED");
+    sim_free(sim);
+    replay_free(replay);
+    return same ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1 && !g_ascii_isdigit(argv[1][0])) return replay_file(argv[1]);
+
+    gint sessions = argc > 1 ? atoi(argv[1]) : 200;
+    if (sessions <= 0) sessions = 200;
+
+    gchar *path = g_build_filename(g_get_tmp_dir(), "bench_replay.rep", NULL);
+    SimContext *sim = sim_new();
+    guint64 total_ticks = 0;
+    gint64 total_bytes = 0;
+    gdouble replay_seconds = 0.0;
+    gint failures = 0;
+
+    for (gint s = 0; s < sessions; s++) {
+        guint64 ticks;
+        gint64 bytes;
+        if (!record_session(sim, (guint64)s, path, &ticks, &bytes)) return 1;
+        total_ticks += ticks;
+        total_bytes += bytes;
+
+        GError *error = NULL;
+        Replay *replay = replay_open(path, &error);
+        if (!replay) {
+            g_printerr("%s\n", error->message);
+            g_error_free(error);
+            return 1;
+        }
+        gint64 start = g_get_monotonic_time();
+        if (!replay_run(replay, sim)) {
+            g_printerr("DIVERGED: session %d (score %d, recorded %d)\n", s, sim_get_score(sim), replay->final_score);
+            failures++;
+        }
+        replay_seconds += (g_get_monotonic_time() - start) / (gdouble)G_USEC_PER_SEC;
+        replay_free(replay);
+    }
+
+    g_print("%d sessions, %" G_GUINT64_FORMAT " ticks, %d diverged\n", sessions, total_ticks, failures);
+    g_print("  log size: %.3f bytes/tick (%.1f bytes per minute of play)\n",
+            (gdouble)total_bytes / total_ticks, (gdouble)total_bytes / total_ticks * 60.0 * BENCH_TICK_RATE);
+    g_print("  playback: %.0f ticks/s (%.0fx real time)\n",
+            total_ticks / replay_seconds, total_ticks / replay_seconds / BENCH_TICK_RATE);
+
+    g_remove(path);
+    g_free(path);
+    sim_free(sim);
+    return failures ? 1 : 0;
+}
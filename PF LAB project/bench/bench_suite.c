@@ -0,0 +1,282 @@
+/* Benchmark suite: hot-path microbenchmarks and full-frame render benchmarks,
+   with machine-readable results for tracking regressions between versions.
+
+   micro/...  check_collision, obstacle_manager_update, obstacle_manager_spawn,
+              sim_update_difficulty and player_update in isolation, plus the
+              cost of a disabled trace scope
+   frame/...  game_render (what the window's draw callback paints) for every
+              GameScreenState into an offscreen 800x600 image surface, with a
+              fixed number of obstacles on screen, at each render scale in
+              render_scales (device pixels per game unit, as on HiDPI or
+              enlarged windows); no display needed
+
+   Every benchmark is warmed up, calibrated to a batch that takes at least
+   --min-sample-us, then sampled --samples times; ns/op statistics (median,
+   p95, stddev, ...) are printed and, with --json=FILE, written as JSON.
+   Run from build/ so the game assets are found in ../assets.
+
+   Usage: bench_suite [--json=FILE] [--filter=SUBSTRING] [--label=TAG]
+                      [--samples=N] [--warmup-ms=N] [--min-sample-us=N] */
+#include <gtk/gtk.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench_harness.h"
+#include "game.h"
+#include "graphics.h"
+#include "sim.h"
+#include "player.h"
+#include "obstacle.h"
+#include "collision.h"
+#include "rng.h"
+#include "trace.h"
+
+#define BENCH_TICK (1.0 / 60.0)
+#define BENCH_SEED 12345
+#define COLLISION_BOXES 1024   // power of two: the body indexes with & (COLLISION_BOXES - 1)
+
+static const guint entity_counts[] = {8, 64, 256};
+static const gdouble render_scales[] = {1.0, 1.25, 1.5, 2.0};
+
+static volatile guint64 sink; // keeps results alive so bodies are not optimised away
+
+/* ---- micro: check_collision ---- */
+
+typedef struct {
+    gdouble x[COLLISION_BOXES], y[COLLISION_BOXES], w[COLLISION_BOXES], h[COLLISION_BOXES];
+} CollisionData;
+
+static void bench_check_collision(gpointer data, guint64 iterations) {
+    const CollisionData *d = data;
+    const gdouble px = GAME_WIDTH / 2.0, py = GAME_HEIGHT - 100.0, pw = 50 * 1.35, ph = 60 * 1.35;
+    guint64 hits = 0;
+    for (guint64 i = 0; i < iterations; i++) {
+        guint k = i & (COLLISION_BOXES - 1);
+        hits += check_collision(px, py, pw, ph, d->x[k], d->y[k], d->w[k], d->h[k]);
+    }
+    sink += hits;
+}
+
+/* ---- micro: obstacle manager ---- */
+
+typedef struct {
+    ObstacleManager *manager;
+    guint entities;
+} ObstacleData;
+
+// Refill the pool with `entities` obstacles spread over the play area
+static void obstacle_fill(gpointer data) {
+    ObstacleData *d = data;
+    Rng rng;
+    rng_seed(&rng, BENCH_SEED, 0);
+    d->manager->pool.count = 0;
+    for (guint i = 0; i < d->entities; i++) {
+        obstacle_manager_add(d->manager, rng_range(&rng, GAME_WIDTH - 60), (gdouble)rng_range(&rng, GAME_HEIGHT + 100) - 100.0,
+                             40.5, 40.5, 250.0 + rng_range(&rng, 200), -1);
+    }
+}
+
+/* dt = 0: positions and the exit scan do their full work but nothing leaves
+   the screen, so every iteration sees the same N obstacles. The grid is only
+   marked dirty here; its rebuild is paid by the next query, not timed. */
+static void bench_obstacle_update(gpointer data, guint64 iterations) {
+    ObstacleData *d = data;
+    for (guint64 i = 0; i < iterations; i++) {
+        obstacle_manager_update(d->manager, 0.0, GAME_HEIGHT);
+    }
+}
+
+static void obstacle_clear(gpointer data) {
+    ObstacleData *d = data;
+    d->manager->pool.count = 0;
+    d->manager->spawn_timer = 0.0;
+}
+
+// spawn_interval = 0: every call takes the spawning branch
+static void bench_obstacle_spawn(gpointer data, guint64 iterations) {
+    ObstacleData *d = data;
+    for (guint64 i = 0; i < iterations; i++) {
+        obstacle_manager_spawn(d->manager, BENCH_TICK, GAME_WIDTH, GAME_HEIGHT);
+    }
+    sink += d->manager->pool.count;
+}
+
+/* ---- micro: difficulty and player ---- */
+
+static void bench_update_difficulty(gpointer data, guint64 iterations) {
+    SimContext *sim = data;
+    for (guint64 i = 0; i < iterations; i++) {
+        sim->score = (gint)(i & 8191); // sweeps all five stages
+        sim_update_difficulty(sim);
+    }
+    sink += (guint64)sim->difficulty_stage;
+}
+
+static void player_setup(gpointer data) {
+    Player *player = data;
+    player->x = GAME_WIDTH / 2.0;
+    player->y = GAME_HEIGHT / 2.0;
+    player->velocity_x = 120.0;
+    player->velocity_y = -80.0;
+    player->angular_velocity = 1.0;
+}
+
+static void bench_player_update(gpointer data, guint64 iterations) {
+    Player *player = data;
+    for (guint64 i = 0; i < iterations; i++) {
+        player_update(player, BENCH_TICK, GAME_WIDTH, GAME_HEIGHT);
+    }
+}
+
+// Cost of one scope left in the code with tracing switched off (the production default)
+static void bench_trace_scope_off(gpointer data, guint64 iterations) {
+    for (guint64 i = 0; i < iterations; i++) {
+        TRACE_BEGIN(trace, "bench");
+        sink += i;
+        TRACE_END(trace);
+    }
+}
+
+/* ---- frame: game_render per screen state ---- */
+
+typedef struct {
+    Game *game;
+    cairo_t *cr;
+} FrameData;
+
+static void bench_frame(gpointer data, guint64 iterations) {
+    FrameData *d = data;
+    for (guint64 i = 0; i < iterations; i++) {
+        game_render(d->game, d->cr);
+    }
+    cairo_surface_flush(cairo_get_target(d->cr));
+}
+
+// Fresh run with `entities` obstacles at the spawn sizes, spread like a busy late game
+static void frame_populate(Game *game, guint entities) {
+    SimContext *sim = game->sim;
+    sim_set_seed(sim, BENCH_SEED);
+    sim_reset(sim);
+    Rng rng;
+    rng_seed(&rng, BENCH_SEED, 1);
+    guint sprites = sim->obstacles->sprite_templates->len;
+    for (guint i = 0; i < entities; i++) {
+        gint sprite_id = sprites ? (gint)rng_range(&rng, sprites) : -1;
+        gdouble x = rng_range(&rng, GAME_WIDTH - 60);
+        gdouble y = (gdouble)rng_range(&rng, GAME_HEIGHT + 60) - 60.0;
+        guint size = rng_range(&rng, OBSTACLE_SIZE_CLASSES);
+        obstacle_manager_add(sim->obstacles, x, y, obstacle_base_size[size][0] * OBSTACLE_SIZE_SCALE,
+                             obstacle_base_size[size][1] * OBSTACLE_SIZE_SCALE, 300.0, sprite_id);
+    }
+    game->state->score = 4321;
+    game->state->level = 4;
+    game->interp_alpha = 0.5;
+}
+
+static void run_frame_benchmarks(BenchReport *report) {
+    static const struct {
+        GameScreenState state;
+        const gchar *name;
+        gboolean has_entities;
+    } screens[] = {
+        {GAME_STATE_MENU, "frame/menu", FALSE},
+        {GAME_STATE_CONTROLS, "frame/controls", FALSE},
+        {GAME_STATE_PLAYING, "frame/playing", TRUE},
+        {GAME_STATE_PAUSED, "frame/paused", TRUE},
+        {GAME_STATE_GAME_OVER, "frame/game_over", FALSE},
+    };
+
+    Game *game = game_new();
+    game_load_assets(game);
+
+    // Scale outermost: the render caches rebuild once per scale, not per benchmark
+    for (guint r = 0; r < G_N_ELEMENTS(render_scales); r++) {
+        gdouble scale = render_scales[r];
+        cairo_surface_t *target = graphics_image_surface_create_scaled(CAIRO_FORMAT_ARGB32, GAME_WIDTH, GAME_HEIGHT, scale);
+        FrameData frame = {game, cairo_create(target)};
+
+        for (guint s = 0; s < G_N_ELEMENTS(screens); s++) {
+            game->state->screen_state = screens[s].state;
+            guint n_counts = screens[s].has_entities ? G_N_ELEMENTS(entity_counts) : 1;
+            for (guint c = 0; c < n_counts; c++) {
+                guint entities = screens[s].has_entities ? entity_counts[c] : 0;
+                frame_populate(game, entities);
+                gchar params[64];
+                g_snprintf(params, sizeof(params), "{\"entities\": %u, \"scale\": %.2f}", entities, scale);
+                bench_report_run(report, screens[s].name, params, bench_frame, NULL, &frame);
+            }
+        }
+
+        cairo_destroy(frame.cr);
+        cairo_surface_destroy(target);
+    }
+    game_cleanup(game);
+}
+
+static void run_micro_benchmarks(BenchReport *report) {
+    CollisionData *collision = g_malloc(sizeof(CollisionData));
+    Rng rng;
+    rng_seed(&rng, BENCH_SEED, 2);
+    for (guint i = 0; i < COLLISION_BOXES; i++) {
+        collision->x[i] = rng_range(&rng, GAME_WIDTH);
+        collision->y[i] = rng_range(&rng, GAME_HEIGHT);
+        collision->w[i] = 30.0 + rng_range(&rng, 70);
+        collision->h[i] = 30.0 + rng_range(&rng, 50);
+    }
+    bench_report_run(report, "micro/check_collision", NULL, bench_check_collision, NULL, collision);
+    g_free(collision);
+
+    ObstacleData obstacles = {obstacle_manager_new(), 0};
+    obstacle_manager_seed(obstacles.manager, BENCH_SEED);
+    for (guint c = 0; c < G_N_ELEMENTS(entity_counts); c++) {
+        gchar params[64];
+        obstacles.entities = entity_counts[c];
+        g_snprintf(params, sizeof(params), "{\"entities\": %u}", obstacles.entities);
+        bench_report_run(report, "micro/obstacle_update", params, bench_obstacle_update, obstacle_fill, &obstacles);
+    }
+    obstacles.manager->spawn_interval = 0.0;
+    bench_report_run(report, "micro/obstacle_spawn", NULL, bench_obstacle_spawn, obstacle_clear, &obstacles);
+    obstacle_manager_free(obstacles.manager);
+
+    SimContext *sim = sim_new();
+    bench_report_run(report, "micro/update_difficulty", NULL, bench_update_difficulty, NULL, sim);
+    sim_free(sim);
+
+    Player *player = player_new(GAME_WIDTH / 2 - 25, GAME_HEIGHT - 100, NULL);
+    bench_report_run(report, "micro/player_update", NULL, bench_player_update, player_setup, player);
+    player_free(player);
+
+    bench_report_run(report, "micro/trace_scope_off", NULL, bench_trace_scope_off, NULL, NULL);
+}
+
+int main(int argc, char **argv) {
+    BenchConfig config;
+    bench_config_defaults(&config);
+    const gchar *json_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (g_str_has_prefix(argv[i], "--json=")) {
+            json_path = argv[i] + strlen("--json=");
+        } else if (!bench_config_parse_option(&config, argv[i])) {
+            g_printerr("Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    BenchReport *report = bench_report_new("car_game", &config);
+    run_micro_benchmarks(report);
+    run_frame_benchmarks(report);
+
+    gint status = 0;
+    if (json_path) {
+        GError *error = NULL;
+        if (bench_report_write_json(report, json_path, &error)) {
+            g_print("results written to %s\n", json_path);
+        } else {
+            g_printerr("Failed to write %s: %s\n", json_path, error->message);
+            g_error_free(error);
+            status = 1;
+        }
+    }
+    bench_report_free(report);
+    return status;
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+# Build the benchmark programs into the build directory
+cd "$(dirname "$0")"
+CFLAGS="-O2 -I../include $(pkg-config --cflags gtk+-3.0)"
+LIBS="$(pkg-config --libs gtk+-3.0) -lm"
+CORE_LIBS="$(pkg-config --libs glib-2.0 gdk-pixbuf-2.0 cairo) -lm"
+bash libcarsim.sh || exit 1
+gcc -o bench_background $CFLAGS ../bench/bench_background.c ../src/background.c ../src/graphics.c $LIBS 2>&1
+gcc -o bench_collision $CFLAGS ../bench/bench_collision.c ../src/obstacle.c ../src/rng.c ../src/trace.c ../src/spatial_grid.c ../src/collision.c ../src/graphics.c $LIBS 2>&1
+# Headless: core library only, no GTK
+gcc -o bench_sim -O2 -I../include $(pkg-config --cflags glib-2.0 gdk-pixbuf-2.0 cairo) ../bench/bench_sim.c libcarsim.a $CORE_LIBS 2>&1
+gcc -o bench_replay -O2 -I../include $(pkg-config --cflags glib-2.0 gdk-pixbuf-2.0 cairo) ../bench/bench_replay.c libcarsim.a $CORE_LIBS 2>&1
+gcc -o bench_difficulty -O2 -I../include $(pkg-config --cflags glib-2.0 gdk-pixbuf-2.0 cairo) ../bench/bench_difficulty.c libcarsim.a $CORE_LIBS 2>&1
+gcc -o bench_input -O2 -I../include $(pkg-config --cflags glib-2.0 gdk-pixbuf-2.0 cairo) ../bench/bench_input.c libcarsim.a $CORE_LIBS 2>&1
+# Suite: microbenchmarks + offscreen frame benchmarks of game_render, JSON results
+gcc -o bench_suite $CFLAGS -I../bench ../bench/bench_suite.c ../bench/bench_harness.c ../src/game.c ../src/background.c ../src/asset_loader.c libcarsim.a $LIBS 2>&1
+echo "Build status: $?"
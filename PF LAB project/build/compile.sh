@@ -1,6 +1,9 @@
 #!/bin/bash
 export PATH=/c/msys64/mingw64/bin:/c/msys64/usr/bin:$PATH
 cd '/c/Users/User/Desktop/PF LAB project/build'
-gcc -o car_game -I../include $(pkg-config --cflags gtk+-3.0) ../src/main.c ../src/game.c ../src/player.c ../src/obstacle.c ../src/graphics.c $(pkg-config --libs gtk+-3.0) -lm 2>&1
+bash libcarsim.sh || exit 1
+# PROFILE=1 bash compile.sh builds the F3 frame-time profiler overlay in
+PROFILE_FLAGS=${PROFILE:+-DPROFILER_ENABLED}
+gcc -o car_game -I../include $PROFILE_FLAGS $(pkg-config --cflags gtk+-3.0) ../src/main.c ../src/game.c ../src/background.c ../src/asset_loader.c ../src/profiler.c libcarsim.a $(pkg-config --libs gtk+-3.0) -lm 2>&1
 echo "Build status: $?"
 ls -lh car_game.exe 2>&1 || echo "Build failed"
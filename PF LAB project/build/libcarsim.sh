@@ -0,0 +1,9 @@
+#!/bin/bash
+# Build the display-free simulation core as a static library (libcarsim.a).
+# Needs only glib, gdk-pixbuf and cairo, so it builds and runs on headless machines.
+cd "$(dirname "$0")"
+CORE_CFLAGS="-O2 -I../include $(pkg-config --cflags glib-2.0 gdk-pixbuf-2.0 cairo)"
+CORE_SRC="../src/sim.c ../src/difficulty.c ../src/player.c ../src/obstacle.c ../src/spatial_grid.c ../src/collision.c ../src/rng.c ../src/replay.c ../src/work_pool.c ../src/trace.c ../src/graphics.c ../src/asset_pack.c ../src/score_store.c ../src/input_queue.c ../src/render_thread.c"
+gcc -c $CORE_CFLAGS $CORE_SRC 2>&1 || exit 1
+ar rcs libcarsim.a sim.o difficulty.o player.o obstacle.o spatial_grid.o collision.o rng.o replay.o work_pool.o trace.o graphics.o asset_pack.o score_store.o input_queue.o render_thread.o
+echo "libcarsim status: $?"
@@ -0,0 +1,7 @@
+#!/bin/bash
+# Build the headless tools (difficulty_eval, pack_assets) against libcarsim.a; no GTK needed
+cd "$(dirname "$0")"
+bash libcarsim.sh || exit 1
+gcc -o difficulty_eval -O2 -I../include $(pkg-config --cflags glib-2.0 gdk-pixbuf-2.0 cairo) ../src/difficulty_eval.c libcarsim.a $(pkg-config --libs glib-2.0 gdk-pixbuf-2.0 cairo) -lm 2>&1 || exit 1
+gcc -o pack_assets -O2 -I../include $(pkg-config --cflags glib-2.0 gdk-pixbuf-2.0 cairo) ../src/pack_assets.c libcarsim.a $(pkg-config --libs glib-2.0 gdk-pixbuf-2.0 cairo) -lm 2>&1
+echo "Build status: $?"
@@ -0,0 +1,40 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+/* Parallel image decoding.
+
+   Each request names a file and an optional fallback file in the assets
+   directory; the first one that decodes wins, and if neither does the
+   request gets graphics_load_image's solid-color placeholder, like the old
+   synchronous loader. asset_loader_start decodes every request on GIO's
+   worker threads (one GTask each) and reports progress on the main thread,
+   so the window can be shown and the menu drawn while images decode.
+   Results are read back per slot, i.e. in request order, no matter which
+   decode finished first.
+
+   With an asset pack (asset_loader_use_pack), requests found in the pack
+   skip decoding entirely: they resolve on start to a packed pixbuf wrapping
+   the mapped, pre-scaled images, and only the rest go to the worker threads. */
+typedef struct AssetLoader AssetLoader;
+
+// Called on the main thread after each finished request; completed == total means all are ready
+typedef void (*AssetLoaderProgressFunc)(AssetLoader *loader, guint completed, guint total, gpointer user_data);
+
+// Asset loader functions
+AssetLoader* asset_loader_new(void);
+guint asset_loader_add(AssetLoader *loader, const gchar *name, const gchar *fallback);
+gboolean asset_loader_use_pack(AssetLoader *loader, const gchar *filename);
+guint asset_loader_get_packed(AssetLoader *loader);
+void asset_loader_start(AssetLoader *loader, AssetLoaderProgressFunc progress, gpointer user_data);
+void asset_loader_run_sync(AssetLoader *loader);
+gboolean asset_loader_is_done(AssetLoader *loader);
+guint asset_loader_get_completed(AssetLoader *loader);
+guint asset_loader_get_count(AssetLoader *loader);
+gdouble asset_loader_get_elapsed_ms(AssetLoader *loader);
+GdkPixbuf* asset_loader_get(AssetLoader *loader, guint slot);
+void asset_loader_free(AssetLoader *loader);
+
+#endif // ASSET_LOADER_H
@@ -0,0 +1,79 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <glib.h>
+#include <cairo.h>
+
+/* Precomputed asset pack, written offline by pack_assets.
+
+   Every image is stored at each size the game draws it, already resampled
+   and converted to cairo's premultiplied ARGB32, so loading is a memory map
+   and drawing wraps the mapped rows with cairo_image_surface_create_for_data:
+   no PNG decoding, scaling or copying at runtime. An image name may appear
+   several times with different sizes.
+
+   File layout (header integers little-endian; pixels are native 32-bit
+   ARGB words, so a pack is only valid on the byte order that wrote it):
+     0  "CGPK"              magic
+     4  guint16 version     ASSET_PACK_VERSION
+     6  guint16 count       number of index entries
+     8  guint32 byte_order  ASSET_PACK_BYTE_ORDER as written by the packer
+    12  guint32 reserved    0
+    16  index               count entries of ASSET_PACK_ENTRY_SIZE bytes:
+          0  char    name[ASSET_PACK_NAME_SIZE]  source file, NUL-terminated
+         40  guint32 width
+         44  guint32 height
+         48  guint32 stride  cairo_format_stride_for_width(ARGB32, width)
+         52  guint32 flags   0
+         56  guint64 offset  first row, a multiple of ASSET_PACK_ALIGN
+    pixels              height rows of stride bytes per entry */
+
+#define ASSET_PACK_MAGIC "CGPK"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_FILE "assets.pack"   // looked up in the assets directory
+#define ASSET_PACK_HEADER_SIZE 16
+#define ASSET_PACK_ENTRY_SIZE 64
+#define ASSET_PACK_NAME_SIZE 40
+#define ASSET_PACK_ALIGN 64             // pixel rows start on a cache line
+#define ASSET_PACK_BYTE_ORDER 0x01020304
+
+#define ASSET_PACK_ERROR (asset_pack_error_quark())
+
+typedef enum {
+    ASSET_PACK_ERROR_FORMAT     // not a pack, unsupported version, wrong byte order or a bad index
+} AssetPackError;
+
+typedef struct {
+    gchar name[ASSET_PACK_NAME_SIZE];
+    guint32 width;
+    guint32 height;
+    guint32 stride;
+    guint64 offset;
+} AssetPackEntry;
+
+typedef struct {
+    GMappedFile *file;
+    const guint8 *data;
+    gsize size;
+    GArray *entries;        // AssetPackEntry, in file order
+} AssetPack;
+
+typedef struct {
+    GPtrArray *names;       // gchar*, parallel to images
+    GPtrArray *images;      // cairo_surface_t* (ARGB32 image surfaces)
+} AssetPackWriter;
+
+GQuark asset_pack_error_quark(void);
+
+// Reading
+AssetPack* asset_pack_open(const gchar *path, GError **error);
+cairo_surface_t* asset_pack_create_surface(AssetPack *pack, guint index);
+void asset_pack_free(AssetPack *pack);
+
+// Writing (pack_assets)
+AssetPackWriter* asset_pack_writer_new(void);
+void asset_pack_writer_add(AssetPackWriter *writer, const gchar *name, cairo_surface_t *image);
+gboolean asset_pack_writer_save(AssetPackWriter *writer, const gchar *path, GError **error);
+void asset_pack_writer_free(AssetPackWriter *writer);
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,29 @@
+#ifndef BACKGROUND_H
+#define BACKGROUND_H
+
+#include <glib.h>
+#include <cairo.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+
+// One scrolling layer: the image is scaled once per render scale and painted through a repeat pattern
+typedef struct {
+    GdkPixbuf *image;       // source, kept to rescale when the render scale changes
+    cairo_surface_t *surface;
+    cairo_pattern_t *pattern;
+    gdouble scale;          // device pixels per unit surface was made at
+    gdouble speed_factor;   // parallax: fraction of the base scroll this layer moves
+} BackgroundLayer;
+
+typedef struct {
+    GPtrArray *layers;      // array of BackgroundLayer*, drawn back to front
+    gint width;
+    gint height;
+} ScrollingBackground;
+
+// Background functions
+ScrollingBackground* background_new(gint width, gint height);
+void background_add_layer(ScrollingBackground *background, GdkPixbuf *image, gdouble speed_factor);
+void background_draw(ScrollingBackground *background, cairo_t *cr, gdouble scroll);
+void background_free(ScrollingBackground *background);
+
+#endif // BACKGROUND_H
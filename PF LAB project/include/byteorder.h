@@ -0,0 +1,43 @@
+#ifndef BYTEORDER_H
+#define BYTEORDER_H
+
+#include <glib.h>
+#include <string.h>
+
+/* Little-endian integers at unaligned offsets of the binary file formats
+   (replays, the asset pack, the score table) */
+
+static inline void put_u16(guint8 *p, guint16 v) {
+    v = GUINT16_TO_LE(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline void put_u32(guint8 *p, guint32 v) {
+    v = GUINT32_TO_LE(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline void put_u64(guint8 *p, guint64 v) {
+    v = GUINT64_TO_LE(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline guint16 get_u16(const guint8 *p) {
+    guint16 v;
+    memcpy(&v, p, sizeof(v));
+    return GUINT16_FROM_LE(v);
+}
+
+static inline guint32 get_u32(const guint8 *p) {
+    guint32 v;
+    memcpy(&v, p, sizeof(v));
+    return GUINT32_FROM_LE(v);
+}
+
+static inline guint64 get_u64(const guint8 *p) {
+    guint64 v;
+    memcpy(&v, p, sizeof(v));
+    return GUINT64_FROM_LE(v);
+}
+
+#endif // BYTEORDER_H
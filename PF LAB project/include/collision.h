@@ -0,0 +1,41 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <glib.h>
+
+/* Hitboxes are shrunk by this fraction of their size before testing */
+#define COLLISION_INSET_RATIO 0.12
+
+/* One side of a collision test with its inset computed once (e.g. the player's
+   box, which does not change during a tick). */
+typedef struct {
+    gdouble x, y, w, h;         // original box
+    gdouble nx, ny;             // inset origin
+    gdouble nx_end, ny_end;     // inset far edges (nx + nw, ny + nh)
+    gboolean inset_valid;       // FALSE when the inset would eliminate the box
+} CollisionBox;
+
+typedef enum {
+    COLLISION_KERNEL_AUTO,      // best kernel the CPU supports
+    COLLISION_KERNEL_SCALAR,
+    COLLISION_KERNEL_SSE2,      // 2 doubles per vector, unrolled to 4 boxes per step
+    COLLISION_KERNEL_AVX2       // 4 doubles per vector, unrolled to 8 boxes per step
+} CollisionKernel;
+
+// Collision functions
+gboolean check_collision(gdouble x1, gdouble y1, gdouble w1, gdouble h1,
+                         gdouble x2, gdouble y2, gdouble w2, gdouble h2);
+
+/* Batched tests of one box against arrays of boxes. Results are bit-identical
+   to calling check_collision(box, box i) for each i. */
+void collision_box_init(CollisionBox *box, gdouble x, gdouble y, gdouble w, gdouble h);
+gboolean collision_box_test(const CollisionBox *box, gdouble x, gdouble y, gdouble w, gdouble h);
+gint collision_first_hit(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                         const gdouble *w, const gdouble *h, guint count);
+void collision_hit_mask(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                        const gdouble *w, const gdouble *h, guint count, guint64 *mask);
+gboolean collision_set_kernel(CollisionKernel kernel);
+CollisionKernel collision_get_kernel(void);
+const gchar* collision_kernel_name(CollisionKernel kernel);
+
+#endif // COLLISION_H
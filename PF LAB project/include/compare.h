@@ -0,0 +1,18 @@
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include <glib.h>
+
+/* Ascending qsort / g_array_sort comparators for the percentile code */
+
+static inline gint compare_doubles(gconstpointer a, gconstpointer b) {
+    gdouble x = *(const gdouble *)a, y = *(const gdouble *)b;
+    return (x > y) - (x < y);
+}
+
+static inline gint compare_floats(gconstpointer a, gconstpointer b) {
+    gfloat x = *(const gfloat *)a, y = *(const gfloat *)b;
+    return (x > y) - (x < y);
+}
+
+#endif // COMPARE_H
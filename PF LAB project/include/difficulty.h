@@ -0,0 +1,82 @@
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+#include <glib.h>
+
+/* Exponential difficulty curves as a function of score.
+
+   difficulty_evaluate is the reference formula set (three pow() calls).
+   A DifficultyTable runs it once per score point when the parameters are
+   loaded, up to the point where each curve reaches its cap, so a lookup is
+   an array read that gives bit-identical results (recorded replays still
+   reproduce). Past the end of a curve that never saturates, lookups fall
+   back to the formula. Tables are immutable and reference counted, so many
+   simulations (difficulty_eval's workers) can share one. */
+
+#define DIFFICULTY_STAGE_COUNT 5
+#define DIFFICULTY_BASE_SPEED 250.0         // obstacle px/s at multiplier 1, before SPEEDUP_FACTOR
+#define DIFFICULTY_BASE_SPAWN_INTERVAL 1.5  // seconds between spawns at multiplier 1
+#define DIFFICULTY_TABLE_MAX_POINTS 65536   // per curve; past this the formula is used
+
+#define DIFFICULTY_ERROR (difficulty_error_quark())
+
+typedef enum {
+    DIFFICULTY_ERROR_INVALID    // a parameter is out of range
+} DifficultyError;
+
+/* Tunables of the curves (defaults in difficulty_params_defaults):
+     speed multiplier = min(max_speed_mult, (1 + score/k_speed)^speed_exponent)
+     spawn multiplier = max(min_spawn_interval / base interval, (1 + score/k_spawn)^-spawn_exponent)
+     score multiplier = min(max_score_mult, 1 + (score/score_scale)^score_exponent) */
+typedef struct {
+    gdouble k_speed;                            // exponent divisor for speed scaling
+    gdouble k_spawn;                            // exponent divisor for spawn scaling
+    gdouble max_speed_mult;                     // cap on the speed multiplier
+    gdouble min_spawn_interval;                 // seconds; floor on the spawn interval
+    gdouble speed_exponent;
+    gdouble spawn_exponent;
+    gdouble score_scale;                        // score at which the score bonus reaches +1
+    gdouble score_exponent;
+    gdouble max_score_mult;                     // cap on the score multiplier
+    gint stage_max[DIFFICULTY_STAGE_COUNT - 1]; // score at which stages 1..4 end
+} DifficultyParams;
+
+// Everything the simulation takes from the curves at one score
+typedef struct {
+    gdouble speed_multiplier;
+    gdouble spawn_multiplier;
+    gdouble score_multiplier;
+    gint stage;                 // 1-5: Easy to Extreme
+} DifficultyLevel;
+
+// One curve sampled at every score point in [0, length)
+typedef struct {
+    gdouble *values;
+    guint length;
+    gboolean saturated;     // values[length - 1] holds for every higher score
+} DifficultyCurve;
+
+typedef struct {
+    DifficultyParams params;
+    DifficultyCurve speed;
+    DifficultyCurve spawn;
+    DifficultyCurve score;
+    gint ref_count;         // atomic
+} DifficultyTable;
+
+GQuark difficulty_error_quark(void);
+
+// Parameters
+void difficulty_params_defaults(DifficultyParams *params);
+gboolean difficulty_params_validate(const DifficultyParams *params, GError **error);
+gboolean difficulty_params_load(DifficultyParams *params, GKeyFile *file, const gchar *group, GError **error);
+gboolean difficulty_params_load_file(DifficultyParams *params, const gchar *path, const gchar *group, GError **error);
+void difficulty_evaluate(const DifficultyParams *params, gint score, DifficultyLevel *out);
+
+// Tables
+DifficultyTable* difficulty_table_new(const DifficultyParams *params);
+DifficultyTable* difficulty_table_ref(DifficultyTable *table);
+void difficulty_table_unref(DifficultyTable *table);
+void difficulty_table_lookup(const DifficultyTable *table, gint score, DifficultyLevel *out);
+
+#endif // DIFFICULTY_H
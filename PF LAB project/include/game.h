@@ -2,11 +2,16 @@
 #define GAME_H
 
 #include <gtk/gtk.h>
+#include "sim.h"
+#include "replay.h"
+#include "asset_loader.h"
+#include "score_store.h"
+#include "input_queue.h"
+#include "render_thread.h"
 
-#define GAME_WIDTH 800
-#define GAME_HEIGHT 600
-#define FPS 60
-#define FRAME_TIME (1000 / FPS)  // milliseconds
+#define TICK_RATE 60.0           // default fixed simulation rate (ticks per second)
+#define MAX_FRAME_DELTA 0.25     // seconds; longer hitches are clamped (spiral-of-death guard)
+#define MAX_TICKS_PER_FRAME 8    // upper bound on catch-up ticks run for one frame
 
 typedef enum {
     GAME_STATE_MENU,
@@ -16,40 +21,77 @@ typedef enum {
     GAME_STATE_GAME_OVER
 } GameScreenState;
 
+#define GAME_SCREEN_STATE_COUNT (GAME_STATE_GAME_OVER + 1)
+
 typedef struct {
     gint score;
     gint level;
-    gint highscore; /* persisted high score loaded from highscore.txt */
+    gint highscore; /* best score in the persisted leaderboard (scores.dat) */
     gboolean is_running;
     gboolean is_paused;
     GameScreenState screen_state;
-    /* Exponential difficulty system */
-    gdouble current_speed_multiplier;  /* Speed scaling factor (1.0+ based on score) */
-    gdouble current_spawn_multiplier;  /* Spawn rate reduction (1.0+ smaller = faster) */
-    gdouble score_multiplier;          /* Points per second multiplier for rewards */
-    gint difficulty_stage;             /* 1-5: Easy to Extreme */
-    gint last_stage_shown;             /* Track which stage announcement was made */
     gboolean arcade_mode;               /* Movement mode: TRUE=Arcade (direct X/Y), FALSE=Physics (rotate+accelerate) */
+    gboolean exact_rotation;            /* Player render quality: TRUE=exact cairo rotation, FALSE=pre-rotated atlas */
 } GameState;
 
+/* Where the GAME_WIDTH x GAME_HEIGHT play area sits in the window: scaled
+   uniformly by fit and centered, the rest filled with letterbox bars */
+typedef struct {
+    gint width;                // window (drawing area) size in window units
+    gint height;
+    gint scale_factor;         // device pixels per window unit (GTK's integer HiDPI factor)
+    gdouble fit;               // window units per game unit
+    gdouble offset_x;          // top-left of the play area, on a device pixel
+    gdouble offset_y;
+} GameViewport;
+
 typedef struct {
     GtkWidget *window;
     GtkWidget *drawing_area;
     GameState *state;
-    guint timer_id;
-    gboolean keys_pressed[4];  // 0=Left, 1=Right, 2=Up, 3=Down
+    SimContext *sim;           // simulation core; the front end feeds it input and draws it
+    guint tick_id;             // GdkFrameClock tick callback driving game_loop
+    gint64 last_frame_time;    // monotonic time (us) of the previous frame, 0 = none yet
+    gdouble accumulator;       // unsimulated time carried between frames (seconds)
+    gdouble tick_rate;         // fixed simulation ticks per second
+    gdouble interp_alpha;      // 0..1 blend between previous and current tick for rendering
+    ReplayRecorder *recorder;  // records every tick of the current run while record_path is set
+    gchar *record_path;        // --record: file the latest run is written to
+    Replay *replay;            // --replay: supplies each tick's input instead of the keyboard
+    gdouble replay_speed;      // replay playback multiplier (1 = real time)
+    InputQueue *input;         // timestamped steering key events, taken tick by tick
+    gint64 tick_end_time;      // monotonic time (us) the tick being simulated ends; earlier input applies to it
+    gboolean threaded_render;  // --render-thread: rasterize on a render thread once assets are ready
+    RenderThread *render;      // draws scene snapshots offscreen; NULL = draw_callback renders itself
+    guint64 render_serial;     // serial of the newest scene snapshot (submitted to render, or drawn directly)
+    GAsyncQueue *spare_frames; // snapshots the render thread has finished with, reused by the next capture
+    GameViewport viewport;     // window size and scale the next frame is drawn for
     gint menu_selected; // index of selected menu item (0=start, 1=quit)
+    guint64 frames_rendered[GAME_SCREEN_STATE_COUNT]; // window frames drawn per screen state
+    AssetLoader *assets;       // images still decoding in the background, NULL once applied
+    ScoreStore *scores;        // leaderboard; loads and saves on its own thread
+    gboolean assets_ready;     // sprites and background attached; runs can start
+    gboolean start_pending;    // a run was requested before the assets were ready
+    gint64 launch_time;        // monotonic time (us) of game_new, for startup metrics
+    gint64 first_frame_time;   // monotonic time (us) of the first drawn frame, 0 = none yet
 } Game;
 
 // Game lifecycle functions
 Game* game_new(void);
 void game_init(Game *game);
+void game_load_assets(Game *game);
 void game_start(Game *game);
 void game_reset(Game *game);
 void game_stop(Game *game);
 void game_pause(Game *game);
 void game_resume(Game *game);
+void game_set_screen_state(Game *game, GameScreenState state);
 void game_update(Game *game, gdouble delta_time);
+void game_set_tick_rate(Game *game, gdouble tick_rate);
+void game_set_record_path(Game *game, const gchar *path);
+void game_set_threaded_render(Game *game, gboolean enabled);
+gboolean game_load_replay(Game *game, const gchar *path, gdouble speed, GError **error);
+gboolean game_load_difficulty(Game *game, const gchar *path, const gchar *group, GError **error);
 void game_render(Game *game, cairo_t *cr);
 void game_cleanup(Game *game);
 
@@ -2,7 +2,6 @@
 #define GRAPHICS_H
 
 #include <cairo.h>
-#include <gdk/gdk.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
 
 // Color definitions
@@ -24,6 +23,14 @@ extern const Color COLOR_GRAY;
 extern const Color COLOR_DARK_BLUE;
 extern const Color COLOR_LIGHT_GRAY;
 
+// Scaled sprite cache statistics (misses == resamples performed)
+typedef struct {
+    guint hits;
+    guint misses;
+    guint entries;
+    guint rescales;     // times the whole cache was dropped for a new render scale
+} SpriteCacheStats;
+
 // Drawing functions
 void graphics_set_color(cairo_t *cr, Color color);
 void graphics_draw_rectangle(cairo_t *cr, gdouble x, gdouble y, gdouble width, gdouble height);
@@ -37,7 +44,46 @@ void graphics_draw_box(cairo_t *cr, gdouble x, gdouble y, gdouble width, gdouble
 GdkPixbuf* graphics_load_image(const gchar *filename);
 void graphics_draw_pixbuf(cairo_t *cr, GdkPixbuf *pixbuf, gdouble x, gdouble y, gdouble width, gdouble height);
 
+// Render scale: device pixels per user unit; caches are built at the scale of the cr they are drawn into
+gdouble graphics_get_scale(cairo_t *cr);
+void graphics_snap_to_pixel(cairo_t *cr, gdouble *x, gdouble *y);
+cairo_surface_t* graphics_image_surface_create_scaled(cairo_format_t format, gint width, gint height, gdouble scale);
+cairo_surface_t* graphics_surface_create_similar_scaled(cairo_t *cr, cairo_content_t content, gint width, gint height);
+
+// Sprite cache: premultiplied surfaces keyed by (pixbuf, width, height) at the render scale.
+// Entries are invalidated automatically when the pixbuf is freed or the scale changes.
+cairo_surface_t* graphics_surface_from_pixbuf(const GdkPixbuf *pixbuf);
+cairo_surface_t* graphics_sprite_cache_lookup(cairo_t *cr, GdkPixbuf *pixbuf, gint width, gint height);
+void graphics_sprite_cache_get_stats(SpriteCacheStats *stats);
+void graphics_sprite_cache_reset_stats(void);
+void graphics_sprite_cache_clear(void);
+
+// Packed images: ready-made surfaces (asset pack) behind a stand-in pixbuf
+GdkPixbuf* graphics_packed_pixbuf_new(void);
+void graphics_packed_pixbuf_add_surface(GdkPixbuf *pixbuf, cairo_surface_t *surface);
+gboolean graphics_pixbuf_is_packed(GdkPixbuf *pixbuf);
+cairo_surface_t* graphics_image_surface_for_pixbuf(GdkPixbuf *pixbuf, gint width, gint height);
+cairo_surface_t* graphics_image_surface_for_pixbuf_scaled(GdkPixbuf *pixbuf, gint width, gint height, gdouble scale);
+
 /* Draw text with a subtle shadow for readability */
 void graphics_draw_text_with_shadow(cairo_t *cr, const gchar *text, gdouble x, gdouble y, gdouble size);
 
+// Cached text: rasterized once per (text, size, color, style) at the render scale, then a plain blit
+typedef enum {
+    GRAPHICS_TEXT_PLAIN,
+    GRAPHICS_TEXT_SHADOW    // white over a 60% black shadow, as graphics_draw_text_with_shadow
+} GraphicsTextStyle;
+
+typedef enum {
+    GRAPHICS_TEXT_LEFT,     // x is the pen position
+    GRAPHICS_TEXT_CENTERED  // x is the horizontal center
+} GraphicsTextAlign;
+
+void graphics_draw_text_cached(cairo_t *cr, const gchar *text, gdouble x, gdouble y, gdouble size,
+                               Color color, GraphicsTextStyle style, GraphicsTextAlign align);
+cairo_surface_t* graphics_text_compose(cairo_t *cr, const gchar *text, gdouble size, Color color,
+                                       GraphicsTextStyle style, gdouble *offset_x, gdouble *offset_y);
+void graphics_text_cache_get_stats(SpriteCacheStats *stats);
+void graphics_text_cache_clear(void);
+
 #endif // GRAPHICS_H
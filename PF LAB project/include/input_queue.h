@@ -0,0 +1,59 @@
+#ifndef INPUT_QUEUE_H
+#define INPUT_QUEUE_H
+
+#include <glib.h>
+
+/* Timestamped key events between the input handlers and the fixed-step loop.
+
+   Handlers push every key change with the time it happened (the event's own
+   timestamp mapped onto g_get_monotonic_time). The loop then takes, for each
+   tick, only the events that happened before that tick's end, so a key acts
+   from the tick it was pressed in rather than from whenever the next frame
+   sampled it. A key pressed and released inside one tick is still held for
+   that tick; the result is a plain SimInputFlags mask per tick, so recorded
+   replays are unchanged.
+
+   The ring is single-producer/single-consumer and lock-free: push is called
+   from one thread, everything else from one (possibly different) thread.
+   The latency probe (on the consumer side) times each event from when it
+   happened to when the first frame captured after the tick that applied it
+   is shown. Frames carry increasing serials, so a frame drawn later (on a
+   render thread) is matched to the events it actually contains. */
+
+#define INPUT_QUEUE_SIZE 256            // events; power of two
+#define INPUT_LATENCY_PENDING 16        // applied events waiting for a frame
+#define INPUT_LATENCY_SAMPLES 512       // latency samples kept; power of two
+#define INPUT_CLOCK_RESYNC_US 1000000   // event clock this far behind = it jumped, resync
+
+typedef struct {
+    gint64 time_us;     // monotonic time the key changed
+    guint key;          // one SimInputFlags bit
+    gboolean pressed;
+} InputEvent;
+
+typedef struct {
+    guint64 events;         // events applied to ticks
+    guint dropped;          // events lost to a full queue
+    guint short_taps;       // presses released within their own tick (lost to per-frame sampling)
+    guint64 latency_count;  // events seen on screen
+    gfloat latency_ms[3];   // p50, p95, max event-to-frame latency over the last INPUT_LATENCY_SAMPLES
+} InputQueueStats;
+
+typedef struct InputQueue InputQueue;
+
+// Input queue functions
+InputQueue* input_queue_new(void);
+void input_queue_free(InputQueue *queue);
+
+// Producer
+gboolean input_queue_push(InputQueue *queue, guint32 event_time_ms, gint64 now_us, guint key, gboolean pressed);
+
+// Consumer
+guint input_queue_take_tick(InputQueue *queue, gint64 tick_end_us);
+void input_queue_flush(InputQueue *queue);
+void input_queue_clear(InputQueue *queue);
+void input_queue_frame_captured(InputQueue *queue, guint64 serial);
+void input_queue_frame_shown(InputQueue *queue, guint64 serial, gint64 frame_time_us);
+void input_queue_get_stats(InputQueue *queue, InputQueueStats *stats);
+
+#endif // INPUT_QUEUE_H
@@ -4,10 +4,14 @@
 #include <glib.h>
 #include <cairo.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
+#include "spatial_grid.h"
+#include "rng.h"
 
+// Standalone obstacle record (compatibility view; live obstacles sit in ObstaclePool)
 typedef struct {
     gdouble x;
     gdouble y;
+    gdouble prev_y;     // y at the start of the current tick, for render interpolation
     gdouble width;
     gdouble height;
     gdouble velocity;
@@ -15,21 +19,96 @@ typedef struct {
     GdkPixbuf *sprite;
 } Obstacle;
 
+#define OBSTACLE_POOL_INITIAL_CAPACITY 64
+/* Spawned obstacles come in OBSTACLE_SIZE_CLASSES sizes (small fast, medium,
+   large slow), obstacle_base_size[class] scaled by OBSTACLE_SIZE_SCALE */
+#define OBSTACLE_SIZE_CLASSES 3
+#define OBSTACLE_SIZE_SCALE 1.35
+extern const gdouble obstacle_base_size[OBSTACLE_SIZE_CLASSES][2];
+/* Transparent gap around every atlas cell, so filtering at fractional
+   positions never samples a neighbouring sprite */
+#define OBSTACLE_ATLAS_PADDING 2
+/* Broad-phase cell size: a little over the largest obstacle (70 * 1.35 = 94.5 px)
+   so an obstacle touches at most 2x2 cells */
+#define OBSTACLE_GRID_CELL_SIZE 100.0
+/* Margin around the play area covered by the grid (obstacles spawn above the top edge) */
+#define OBSTACLE_GRID_MARGIN 100.0
+
+/* Live obstacles in struct-of-arrays layout: index i across every array is one
+   obstacle. Dead entries are swap-removed, so [0, count) is always dense. */
+typedef struct {
+    gdouble *x;
+    gdouble *y;
+    gdouble *prev_y;
+    gdouble *w;
+    gdouble *h;
+    gdouble *vel;
+    gint *sprite_id;    // index into ObstacleManager.sprite_templates, -1 = none
+    guint count;
+    guint capacity;     // grows by doubling, never shrinks
+} ObstaclePool;
+
+/* All random state of an ObstacleManager, for snapshot/restore */
+typedef struct {
+    Rng spawn;      // gameplay draws: obstacle type and x position
+    Rng sprite;     // cosmetic draws: which sprite template to show
+} ObstacleRngState;
+
+/* Every sprite template at every size class in one surface: template t at
+   class c is the cell at column t, row c. Built on the first draw (and again
+   if the templates or the render scale change) so a frame of obstacles
+   paints from one source. A manager replacing another for a new run takes
+   over its atlas (obstacle_manager_take_atlas), so runs do not rebuild it. */
+typedef struct {
+    cairo_surface_t *surface;   // NULL until built; similar to the first draw target
+    cairo_pattern_t *pattern;   // the one source for every atlas blit
+    guint templates;            // sprite_templates->len it was built for
+    GPtrArray *sources;         // the templates it was built from, referenced
+    gdouble scale;              // device pixels per game unit it was built at
+    gint cell_w[OBSTACLE_SIZE_CLASSES];     // class sizes in whole pixels, as drawn
+    gint cell_h[OBSTACLE_SIZE_CLASSES];
+    gint row_y[OBSTACLE_SIZE_CLASSES];
+    gint column_width;
+    /* Draw scratch: visible obstacles bucketed by region (c * templates + t),
+       plus a last bucket for obstacles drawn without the atlas */
+    guint *bucket_start;        // regions + 2 entries
+    guint *order;               // pool indices grouped by bucket
+    guint order_capacity;
+} ObstacleAtlas;
+
 typedef struct {
-    GPtrArray *obstacles;
+    ObstaclePool pool;
+    SpatialGrid *grid;      // broad phase over pool, rebuilt lazily by obstacle_manager_query_rect
+    gboolean grid_dirty;    // pool changed since the last rebuild
     gdouble spawn_timer;
     gdouble spawn_interval;
     gdouble obstacle_speed;
     /* Multiple sprite templates to allow obstacle variety */
     GPtrArray *sprite_templates; /* array of GdkPixbuf* */
+    /* Per-manager PRNG streams; sprite picks use their own stream so the set of
+       loaded sprites never changes where obstacles spawn */
+    ObstacleRngState rng;
+    ObstacleAtlas atlas;    // drawing only; the simulation never reads it
 } ObstacleManager;
 
 // Obstacle functions
 Obstacle* obstacle_new(gdouble x, gdouble y, gdouble width, gdouble height, gdouble velocity, GdkPixbuf *sprite);
 ObstacleManager* obstacle_manager_new(void);
+void obstacle_manager_seed(ObstacleManager *manager, guint64 seed);
+void obstacle_manager_save_rng(const ObstacleManager *manager, ObstacleRngState *out);
+void obstacle_manager_restore_rng(ObstacleManager *manager, const ObstacleRngState *state);
+guint obstacle_manager_add(ObstacleManager *manager, gdouble x, gdouble y, gdouble width, gdouble height, gdouble velocity, gint sprite_id);
+guint obstacle_manager_add_obstacle(ObstacleManager *manager, const Obstacle *obstacle);
+void obstacle_manager_get(ObstacleManager *manager, guint index, Obstacle *out);
 void obstacle_manager_update(ObstacleManager *manager, gdouble delta_time, gint height);
-void obstacle_manager_spawn(ObstacleManager *manager, gint width, gint height);
-void obstacle_manager_draw(ObstacleManager *manager, cairo_t *cr);
+void obstacle_manager_save_previous_state(ObstacleManager *manager);
+guint obstacle_manager_query_rect(ObstacleManager *manager, gdouble x, gdouble y, gdouble width, gdouble height, const guint **candidates);
+guint obstacle_manager_query_obstacle(ObstacleManager *manager, guint index, guint *candidates, guint max_candidates);
+void obstacle_manager_spawn(ObstacleManager *manager, gdouble delta_time, gint width, gint height);
+void obstacle_manager_draw(ObstacleManager *manager, cairo_t *cr, gdouble alpha);
+void obstacle_manager_take_atlas(ObstacleManager *manager, ObstacleManager *from);
+void obstacle_pool_copy(ObstaclePool *dst, const ObstaclePool *src);
+void obstacle_pool_clear(ObstaclePool *pool);
 void obstacle_free(Obstacle *obstacle);
 void obstacle_manager_free(ObstacleManager *manager);
 
@@ -5,6 +5,18 @@
 #include <cairo.h>
 #include <gdk-pixbuf/gdk-pixbuf.h>
 
+/* Car size on screen: the 50x60 car scaled up ~35% for visibility */
+#define PLAYER_WIDTH (50 * 1.35)
+#define PLAYER_HEIGHT (60 * 1.35)
+
+/* Number of pre-rotated frames kept in the player sprite atlas */
+#define PLAYER_ATLAS_FRAMES 64
+
+typedef enum {
+    PLAYER_QUALITY_ATLAS,   // nearest pre-rotated atlas frame (fast path)
+    PLAYER_QUALITY_EXACT    // rotate the cached upright sprite through cairo
+} PlayerRenderQuality;
+
 typedef struct {
     gdouble x;
     gdouble y;
@@ -15,10 +27,20 @@ typedef struct {
     gdouble speed;
     gdouble max_speed;
     gdouble angle; // facing direction in radians
+    // state at the start of the current tick, for render interpolation
+    gdouble prev_x;
+    gdouble prev_y;
+    gdouble prev_angle;
     gdouble angular_velocity;
     // drift helper: lower lateral_damping => more slide
     gdouble lateral_damping;
     GdkPixbuf *sprite;
+    // render caches built on the first player_draw
+    PlayerRenderQuality render_quality;
+    cairo_surface_t *upright;                     // scaled sprite (or procedural car), unrotated
+    cairo_surface_t *atlas[PLAYER_ATLAS_FRAMES];  // pre-rotated copies of upright
+    gint atlas_size;                              // side length of each square atlas frame
+    gdouble render_scale;                         // device pixels per unit the caches were built at
 } Player;
 
 // Player functions
@@ -30,7 +52,10 @@ void player_move_up(Player *player, gdouble delta_time);
 void player_move_down(Player *player, gdouble delta_time);
 void player_stop_x(Player *player);
 void player_stop_y(Player *player);
-void player_draw(Player *player, cairo_t *cr);
+void player_save_previous_state(Player *player);
+void player_draw(Player *player, cairo_t *cr, gdouble alpha);
+void player_set_render_quality(Player *player, PlayerRenderQuality quality);
+void player_copy_state(Player *dst, const Player *src);
 void player_free(Player *player);
 
 #endif // PLAYER_H
@@ -0,0 +1,55 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <glib.h>
+#include <cairo.h>
+
+/* Frame-time profiler with an F3 overlay: per-frame input, simulation and
+   render times plus the frame-to-frame interval, kept in a lock-free ring.
+
+   Only built with -DPROFILER_ENABLED (PROFILE=1 bash build/compile.sh). In
+   normal builds every PROFILE_* macro expands to nothing and profiler.c
+   compiles to an empty object, so release binaries carry no trace of it. */
+
+typedef enum {
+    PROFILER_PHASE_INPUT,      // held keys / replay byte to SimInputFlags, recording
+    PROFILER_PHASE_SIM,        // sim_step and its outcome handling, summed over the frame's ticks
+    PROFILER_PHASE_RENDER,     // game_render from the draw callback
+    PROFILER_PHASE_INTERVAL,   // frame clock time since the previous frame
+    PROFILER_PHASE_COUNT
+} ProfilerPhase;
+
+#define PROFILER_RING_SIZE 512       // frames kept; power of two
+#define PROFILER_WINDOW_FRAMES 240   // frames shown in the graph and percentiles
+
+typedef struct {
+    gfloat ms[PROFILER_PHASE_COUNT];
+    guint16 ticks;      // simulation ticks run in this frame
+    guint16 dropped;    // display refreshes missed before this frame
+} ProfilerFrame;
+
+#ifdef PROFILER_ENABLED
+
+void profiler_frame_begin(gint64 frame_time_us, gint64 refresh_interval_us);
+void profiler_frame_resume(void);
+void profiler_add(ProfilerPhase phase, gint64 elapsed_us);
+void profiler_add_tick(void);
+guint profiler_read(ProfilerFrame *out, guint max_frames);
+gboolean profiler_toggle(void);
+void profiler_draw(cairo_t *cr, gdouble x, gdouble y);
+
+#define PROFILE_TIME_BEGIN(var) gint64 var = g_get_monotonic_time()
+#define PROFILE_TIME_END(var, phase) profiler_add((phase), g_get_monotonic_time() - (var))
+#define PROFILE_TICK() profiler_add_tick()
+#define PROFILE_DRAW_OVERLAY(cr, x, y) profiler_draw((cr), (x), (y))
+
+#else
+
+#define PROFILE_TIME_BEGIN(var)
+#define PROFILE_TIME_END(var, phase)
+#define PROFILE_TICK()
+#define PROFILE_DRAW_OVERLAY(cr, x, y)
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
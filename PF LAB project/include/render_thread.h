@@ -0,0 +1,43 @@
+#ifndef RENDER_THREAD_H
+#define RENDER_THREAD_H
+
+#include <glib.h>
+#include <cairo.h>
+
+/* Rasterization on a dedicated thread into two offscreen image surfaces.
+
+   The owner submits immutable frame descriptions (scene snapshots); the
+   thread draws the newest one into the back buffer and swaps it to the
+   front, then tells the owner on its main context. render_thread_paint
+   blits the front buffer. A frame submitted while an older one is still
+   waiting replaces it, so a slow renderer drops frames instead of queueing
+   latency. The swap and the blit share one lock, so the buffer being
+   painted is never the one being drawn. Buffers are width x height units at
+   scale device pixels per unit; after render_thread_resize the thread
+   reallocates each one the next time it draws into it. */
+
+// Draws one submitted frame into cr (render thread)
+typedef void (*RenderThreadDrawFunc)(gpointer frame, cairo_t *cr, gpointer user_data);
+// A newer buffer is ready to paint (owner's main context)
+typedef void (*RenderThreadReadyFunc)(gpointer user_data);
+
+typedef struct {
+    guint64 submitted;
+    guint64 rendered;
+    guint64 dropped;        // replaced before the thread got to them
+    gdouble render_ms;      // mean time to draw one frame on the thread
+} RenderThreadStats;
+
+typedef struct RenderThread RenderThread;
+
+// Render thread functions
+RenderThread* render_thread_new(gint width, gint height, gdouble scale, RenderThreadDrawFunc draw, GDestroyNotify free_frame,
+                                RenderThreadReadyFunc ready, gpointer user_data);
+void render_thread_resize(RenderThread *thread, gint width, gint height, gdouble scale);
+void render_thread_submit(RenderThread *thread, gpointer frame, guint64 serial);
+guint64 render_thread_paint(RenderThread *thread, cairo_t *cr);
+void render_thread_flush(RenderThread *thread);
+void render_thread_get_stats(RenderThread *thread, RenderThreadStats *stats);
+void render_thread_free(RenderThread *thread);
+
+#endif // RENDER_THREAD_H
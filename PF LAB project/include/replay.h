@@ -0,0 +1,77 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <glib.h>
+#include "sim.h"
+
+/* Input recording and replay.
+
+   A replay is the seed, the tick rate and one input byte per simulated tick
+   (SimInputFlags plus REPLAY_INPUT_ARCADE for the movement mode), stored
+   run-length encoded. Feeding the same bytes to sim_step from the same seed
+   reproduces the run exactly.
+
+   File layout (all integers little-endian):
+     0  "CGRP"              magic
+     4  guint16 version     REPLAY_VERSION
+     6  guint16 reserved    0
+     8  guint64 seed
+    16  gdouble tick_rate   IEEE-754 bits as guint64
+    24  guint64 tick_count  total ticks recorded
+    32  gint32  final_score score when recording stopped
+    36  guint32 flags       REPLAY_FLAG_*
+    40  runs                (input byte, LEB128 run length >= 1) until end of file */
+
+#define REPLAY_MAGIC "CGRP"
+#define REPLAY_VERSION 1
+#define REPLAY_HEADER_SIZE 40
+#define REPLAY_INPUT_ARCADE (1 << 4)    // tick was simulated in Arcade movement mode
+#define REPLAY_FLAG_GAME_OVER (1 << 0)  // recording ended on a collision
+
+#define REPLAY_ERROR (replay_error_quark())
+
+typedef enum {
+    REPLAY_ERROR_FORMAT     // not a replay file, or an unsupported version
+} ReplayError;
+
+typedef struct {
+    GByteArray *runs;       // encoded runs closed so far
+    guint64 seed;
+    gdouble tick_rate;
+    guint64 tick_count;
+    guint8 run_input;       // input byte of the open run
+    guint64 run_length;     // ticks in the open run, 0 = none yet
+} ReplayRecorder;
+
+typedef struct {
+    GMappedFile *file;      // long logs are paged in on demand, never copied
+    const guint8 *data;
+    gsize size;
+    guint64 seed;
+    gdouble tick_rate;
+    guint64 tick_count;
+    gint final_score;
+    guint32 flags;
+    /* decode cursor */
+    gsize pos;
+    guint8 run_input;
+    guint64 run_left;
+    guint64 tick;
+} Replay;
+
+GQuark replay_error_quark(void);
+
+// Recording
+ReplayRecorder* replay_recorder_new(guint64 seed, gdouble tick_rate);
+void replay_recorder_push(ReplayRecorder *recorder, guint8 tick_input);
+gboolean replay_recorder_save(ReplayRecorder *recorder, const gchar *path, gint final_score, guint32 flags, GError **error);
+void replay_recorder_free(ReplayRecorder *recorder);
+
+// Playback
+Replay* replay_open(const gchar *path, GError **error);
+gboolean replay_next(Replay *replay, guint8 *tick_input);
+void replay_rewind(Replay *replay);
+gboolean replay_run(Replay *replay, SimContext *sim);
+void replay_free(Replay *replay);
+
+#endif // REPLAY_H
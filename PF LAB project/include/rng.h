@@ -0,0 +1,23 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <glib.h>
+
+/* PCG32 (XSH-RR, 64-bit state) pseudo-random generator. The whole state is
+   this plain struct, so each owner keeps its own stream (no shared global
+   state, safe to use from parallel simulations) and a snapshot is a copy.
+   Same seed + stream => same sequence on every platform. */
+typedef struct {
+    guint64 state;
+    guint64 inc;    // stream selector, always odd
+} Rng;
+
+// Rng functions
+void rng_seed(Rng *rng, guint64 seed, guint64 stream);
+guint32 rng_next_u32(Rng *rng);
+guint32 rng_range(Rng *rng, guint32 bound);
+gdouble rng_next_double(Rng *rng);
+void rng_snapshot(const Rng *rng, Rng *out);
+void rng_restore(Rng *rng, const Rng *snapshot);
+
+#endif // RNG_H
@@ -0,0 +1,59 @@
+#ifndef SCORE_STORE_H
+#define SCORE_STORE_H
+
+#include <glib.h>
+
+/* High-score leaderboard persisted off the game thread.
+
+   The table lives in memory; score_store_submit inserts into it and only
+   queues a write, so finishing a run never touches the disk. A writer
+   thread loads the file once at startup (the caller is told on its main
+   context when that is done), then rewrites the whole table atomically
+   (temporary file + rename, via g_file_set_contents) whenever it changed,
+   coalescing bursts into one write. A crash mid-write leaves the previous
+   file intact.
+
+   File layout (little-endian):
+     0  "CGHS"          magic
+     4  guint16 version SCORE_STORE_VERSION
+     6  guint16 count   entries that follow, best first (<= SCORE_STORE_MAX_ENTRIES)
+     8  entries         SCORE_STORE_ENTRY_SIZE bytes each:
+          0  guint32 score
+          4  guint32 mode       ScoreMode
+          8  gint64  timestamp  unix seconds the run ended, 0 = unknown */
+
+#define SCORE_STORE_MAGIC "CGHS"
+#define SCORE_STORE_VERSION 1
+#define SCORE_STORE_FILE "scores.dat"
+#define SCORE_STORE_LEGACY_FILE "highscore.txt"   // single number, imported once if SCORE_STORE_FILE is missing
+#define SCORE_STORE_HEADER_SIZE 8
+#define SCORE_STORE_ENTRY_SIZE 16
+#define SCORE_STORE_MAX_ENTRIES 10
+
+typedef enum {
+    SCORE_MODE_PHYSICS = 0,
+    SCORE_MODE_ARCADE = 1,
+    SCORE_MODE_UNKNOWN = 2      // imported from the legacy file
+} ScoreMode;
+
+typedef struct {
+    gint score;
+    ScoreMode mode;
+    gint64 timestamp;
+} ScoreEntry;
+
+typedef struct ScoreStore ScoreStore;
+
+// Called on the creating thread's main context once the file has been read
+typedef void (*ScoreStoreLoadedFunc)(ScoreStore *store, gpointer user_data);
+
+// Score store functions
+ScoreStore* score_store_new(const gchar *path, ScoreStoreLoadedFunc loaded, gpointer user_data);
+gboolean score_store_is_loaded(ScoreStore *store);
+void score_store_wait_loaded(ScoreStore *store);
+gint score_store_submit(ScoreStore *store, gint score, ScoreMode mode);
+gint score_store_get_best(ScoreStore *store);
+guint score_store_get_entries(ScoreStore *store, ScoreEntry *out, guint max_entries);
+void score_store_free(ScoreStore *store);
+
+#endif // SCORE_STORE_H
@@ -0,0 +1,71 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <glib.h>
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include "player.h"
+#include "obstacle.h"
+#include "difficulty.h"
+
+/* Display-free simulation core: everything that decides the outcome of a run
+   (player physics, obstacles, collisions, score and difficulty) with no GTK/GDK
+   dependency. Built as libcarsim.a; the GTK front end in game.c is a client. */
+
+#define GAME_WIDTH 800
+#define GAME_HEIGHT 600
+/* Speedup factor applied to major movement/score rates (20-30% increase) */
+#define SPEEDUP_FACTOR 1.25
+
+/* Held keys for one tick, one bit each (replay logs store the same bits) */
+typedef enum {
+    SIM_INPUT_LEFT  = 1 << 0,
+    SIM_INPUT_RIGHT = 1 << 1,
+    SIM_INPUT_UP    = 1 << 2,
+    SIM_INPUT_DOWN  = 1 << 3
+} SimInputFlags;
+
+typedef struct {
+    Player *player;
+    ObstacleManager *obstacles;
+    DifficultyTable *difficulty;    // curve used by this context (shared, read-only)
+    GdkPixbuf *player_sprite;       // optional; NULL draws the procedural car
+    GPtrArray *obstacle_sprites;    // GdkPixbuf* templates handed to each new ObstacleManager
+    gboolean arcade_mode;           // TRUE=Arcade (direct X/Y), FALSE=Physics (rotate+accelerate)
+    gboolean game_over;             // set by the tick that detected a collision
+    guint64 seed;                   // obstacle RNG seed applied by every sim_reset
+    guint64 tick;                   // ticks simulated since the last reset
+    gint score;
+    gint level;
+    gdouble score_accum;            // fractional score carried between ticks
+    /* Exponential difficulty system */
+    gdouble current_speed_multiplier;  // Speed scaling factor (1.0+ based on score)
+    gdouble current_spawn_multiplier;  // Spawn rate reduction (1.0+ smaller = faster)
+    gdouble score_multiplier;          // Points per second multiplier for rewards
+    gint difficulty_stage;             // 1-5: Easy to Extreme
+    gint last_stage_shown;             // Track which stage announcement was made
+} SimContext;
+
+// Lifecycle
+SimContext* sim_new(void);
+void sim_set_player_sprite(SimContext *sim, GdkPixbuf *sprite);
+void sim_add_obstacle_sprite(SimContext *sim, GdkPixbuf *sprite);
+void sim_set_arcade_mode(SimContext *sim, gboolean arcade_mode);
+void sim_set_seed(SimContext *sim, guint64 seed);
+void sim_set_difficulty(SimContext *sim, const DifficultyParams *params);
+void sim_set_difficulty_table(SimContext *sim, DifficultyTable *table);
+void sim_reset(SimContext *sim);
+void sim_free(SimContext *sim);
+
+// Advance one fixed tick of delta_time seconds with the given SimInputFlags held
+void sim_step(SimContext *sim, guint input, gdouble delta_time);
+
+// Look up the difficulty multipliers and stage for the current score (sim_step does this once per tick)
+void sim_update_difficulty(SimContext *sim);
+
+// Queries
+gboolean sim_is_over(const SimContext *sim);
+gint sim_get_score(const SimContext *sim);
+guint64 sim_get_tick(const SimContext *sim);
+const gchar* sim_stage_name(gint stage);
+
+#endif // SIM_H
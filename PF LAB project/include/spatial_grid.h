@@ -0,0 +1,34 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <glib.h>
+
+/* Uniform grid broad phase over axis-aligned boxes.
+   Rebuilt from parallel x/y/w/h arrays with a counting sort, so a rebuild is
+   two linear passes and does not allocate once buffers have grown. A box is
+   listed in every cell it overlaps; boxes outside the grid are clamped into
+   the border cells. */
+typedef struct {
+    gdouble origin_x;
+    gdouble origin_y;
+    gdouble cell_size;
+    gint cols;
+    gint rows;
+    guint *cell_start;      // cols*rows + 1 offsets into items
+    guint *cell_fill;       // scratch write cursor per cell
+    guint *items;           // box indices grouped by cell
+    guint item_capacity;
+    guint *stamp;           // last query id that reported box i (dedup)
+    guint *results;         // unique candidates from the last query
+    guint box_capacity;
+    guint query_id;
+} SpatialGrid;
+
+// Spatial grid functions
+SpatialGrid* spatial_grid_new(gdouble origin_x, gdouble origin_y, gdouble width, gdouble height, gdouble cell_size);
+void spatial_grid_rebuild(SpatialGrid *grid, const gdouble *x, const gdouble *y,
+                          const gdouble *w, const gdouble *h, guint count);
+guint spatial_grid_query(SpatialGrid *grid, gdouble x, gdouble y, gdouble w, gdouble h, const guint **results);
+void spatial_grid_free(SpatialGrid *grid);
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,19 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <glib.h>
+
+/* Work-stealing parallel loop over [0, n_items).
+
+   Every worker starts with an even slice of the index range and takes items
+   from the front of its own slice. A worker that runs dry steals the back
+   half of the largest remaining slice, so uneven item costs (short and long
+   games) still keep all cores busy until the very end. The calling thread is
+   worker 0. */
+typedef void (*WorkPoolFunc)(guint index, guint worker, gpointer user_data);
+
+// Work pool functions
+guint work_pool_default_workers(void);
+void work_pool_run(guint n_items, guint n_workers, WorkPoolFunc func, gpointer user_data);
+
+#endif // WORK_POOL_H
@@ -1,3 +1,3 @@
 @echo off
 cd /d "C:\Users\User\Desktop\PF LAB project\build"
-C:\msys64\usr\bin\bash.exe -i -c "gcc -o car_game -I../include $(pkg-config --cflags gtk+-3.0) ../src/main.c ../src/game.c ../src/player.c ../src/obstacle.c ../src/graphics.c $(pkg-config --libs gtk+-3.0) -lm && echo SUCCESS"
+C:\msys64\usr\bin\bash.exe -i -c "bash libcarsim.sh && gcc -o car_game -I../include $(pkg-config --cflags gtk+-3.0) ../src/main.c ../src/game.c ../src/background.c ../src/asset_loader.c ../src/profiler.c libcarsim.a $(pkg-config --libs gtk+-3.0) -lm && echo SUCCESS"
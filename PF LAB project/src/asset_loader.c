@@ -0,0 +1,247 @@
+#include "asset_loader.h"
+#include "asset_pack.h"
+#include "graphics.h"
+#include "trace.h"
+#include <gio/gio.h>
+#include <string.h>
+
+typedef struct {
+    gchar *name;
+    gchar *fallback;        // NULL = none
+    GdkPixbuf *pixbuf;      // written once by the decoding thread
+} AssetRequest;
+
+struct AssetLoader {
+    GPtrArray *requests;    // AssetRequest*, indexed by slot
+    guint completed;
+    guint packed;           // requests served from the pack
+    AssetPack *pack;        // NULL = decode everything
+    guint ref_count;        // main thread only: the owner plus one per task in flight
+    gboolean cancelled;     // owner freed the loader; drop late results silently
+    GCancellable *cancellable;
+    AssetLoaderProgressFunc progress;
+    gpointer user_data;
+    gint64 start_time;
+    gint64 finish_time;
+};
+
+/* The assets directory is looked up once per process instead of probing
+   every candidate location for every file; images missing from it are still
+   looked for in the current directory (decode_request) */
+static const gchar* asset_dir(void) {
+    static gsize resolved = 0;
+    static const gchar *dir = ".";
+    if (g_once_init_enter(&resolved)) {
+        const gchar *candidates[] = {"assets", "../assets"};
+        for (guint i = 0; i < G_N_ELEMENTS(candidates); i++) {
+            if (g_file_test(candidates[i], G_FILE_TEST_IS_DIR)) {
+                dir = candidates[i];
+                break;
+            }
+        }
+        g_once_init_leave(&resolved, 1);
+    }
+    return dir;
+}
+
+static GdkPixbuf* decode_request(const AssetRequest *request) {
+    TRACE_BEGIN(trace, "asset_decode");
+    const gchar *candidates[] = {request->name, request->fallback};
+    const gchar *dirs[] = {asset_dir(), "."};
+    guint n_dirs = strcmp(dirs[0], ".") == 0 ? 1 : 2;
+    GdkPixbuf *pixbuf = NULL;
+    for (guint i = 0; i < G_N_ELEMENTS(candidates) && !pixbuf; i++) {
+        if (!candidates[i]) continue;
+        for (guint d = 0; d < n_dirs && !pixbuf; d++) {
+            gchar *path = g_build_filename(dirs[d], candidates[i], NULL);
+            pixbuf = gdk_pixbuf_new_from_file(path, NULL);
+            g_free(path);
+        }
+    }
+    // Nothing decoded: graphics_load_image logs it and returns a solid-color placeholder
+    if (!pixbuf) pixbuf = graphics_load_image(request->name);
+    TRACE_END(trace);
+    return pixbuf;
+}
+
+static void request_free(gpointer data) {
+    AssetRequest *request = data;
+    g_free(request->name);
+    g_free(request->fallback);
+    if (request->pixbuf) g_object_unref(request->pixbuf);
+    g_free(request);
+}
+
+static void asset_loader_unref(AssetLoader *loader) {
+    if (--loader->ref_count > 0) return;
+    g_ptr_array_free(loader->requests, TRUE);
+    asset_pack_free(loader->pack);
+    g_object_unref(loader->cancellable);
+    g_free(loader);
+}
+
+AssetLoader* asset_loader_new(void) {
+    AssetLoader *loader = g_malloc0(sizeof(AssetLoader));
+    loader->requests = g_ptr_array_new_with_free_func(request_free);
+    loader->ref_count = 1;
+    loader->cancellable = g_cancellable_new();
+    return loader;
+}
+
+// Queue a file (and an optional fallback) before starting; returns its slot
+guint asset_loader_add(AssetLoader *loader, const gchar *name, const gchar *fallback) {
+    AssetRequest *request = g_malloc0(sizeof(AssetRequest));
+    request->name = g_strdup(name);
+    request->fallback = g_strdup(fallback);
+    g_ptr_array_add(loader->requests, request);
+    return loader->requests->len - 1;
+}
+
+/* Serve requests from an asset pack in the assets directory. A missing pack is
+   normal (the PNGs are used); a damaged or foreign one is reported and ignored. */
+gboolean asset_loader_use_pack(AssetLoader *loader, const gchar *filename) {
+    gchar *path = g_build_filename(asset_dir(), filename, NULL);
+    if (!g_file_test(path, G_FILE_TEST_IS_REGULAR)) {
+        g_free(path);
+        return FALSE;
+    }
+    GError *error = NULL;
+    AssetPack *pack = asset_pack_open(path, &error);
+    if (!pack) {
+        g_warning("Ignoring asset pack: %s", error->message);
+        g_error_free(error);
+        g_free(path);
+        return FALSE;
+    }
+    asset_pack_free(loader->pack);
+    loader->pack = pack;
+    g_free(path);
+    return TRUE;
+}
+
+/* Packed pixbuf with every stored size of the first of name/fallback the pack
+   holds, or NULL if it holds neither */
+static GdkPixbuf* pack_lookup(AssetPack *pack, const AssetRequest *request) {
+    const gchar *candidates[] = {request->name, request->fallback};
+    for (guint c = 0; c < G_N_ELEMENTS(candidates); c++) {
+        if (!candidates[c]) continue;
+        GdkPixbuf *pixbuf = NULL;
+        for (guint i = 0; i < pack->entries->len; i++) {
+            if (strcmp(g_array_index(pack->entries, AssetPackEntry, i).name, candidates[c]) != 0) continue;
+            if (!pixbuf) pixbuf = graphics_packed_pixbuf_new();
+            cairo_surface_t *surface = asset_pack_create_surface(pack, i);
+            graphics_packed_pixbuf_add_surface(pixbuf, surface);
+            cairo_surface_destroy(surface);
+        }
+        if (pixbuf) return pixbuf;
+    }
+    return NULL;
+}
+
+// Resolve every packed request in place; these never reach a worker thread
+static void resolve_packed(AssetLoader *loader) {
+    if (!loader->pack) return;
+    for (guint i = 0; i < loader->requests->len; i++) {
+        AssetRequest *request = g_ptr_array_index(loader->requests, i);
+        request->pixbuf = pack_lookup(loader->pack, request);
+        if (request->pixbuf) loader->packed++;
+    }
+    loader->completed += loader->packed;
+}
+
+static void decode_thread(GTask *task, gpointer source_object, gpointer task_data, GCancellable *cancellable) {
+    AssetRequest *request = task_data;
+    if (!g_cancellable_is_cancelled(cancellable)) {
+        request->pixbuf = decode_request(request);
+    }
+    g_task_return_boolean(task, TRUE);
+}
+
+static void decode_finished(GObject *source_object, GAsyncResult *result, gpointer user_data) {
+    AssetLoader *loader = user_data;
+    if (!loader->cancelled) {
+        loader->completed++;
+        if (loader->completed == loader->requests->len) {
+            loader->finish_time = g_get_monotonic_time();
+        }
+        if (loader->progress) {
+            loader->progress(loader, loader->completed, loader->requests->len, loader->user_data);
+        }
+    }
+    asset_loader_unref(loader);
+}
+
+/* Decode every request in parallel. progress runs on the calling thread's
+   main context after each one; with no requests it runs once immediately. */
+void asset_loader_start(AssetLoader *loader, AssetLoaderProgressFunc progress, gpointer user_data) {
+    loader->progress = progress;
+    loader->user_data = user_data;
+    loader->start_time = g_get_monotonic_time();
+    resolve_packed(loader);
+    if (asset_loader_is_done(loader)) {
+        loader->finish_time = g_get_monotonic_time();
+        if (progress) progress(loader, loader->completed, loader->requests->len, user_data);
+        return;
+    }
+    for (guint i = 0; i < loader->requests->len; i++) {
+        AssetRequest *request = g_ptr_array_index(loader->requests, i);
+        if (request->pixbuf) continue;
+        GTask *task = g_task_new(NULL, loader->cancellable, decode_finished, loader);
+        g_task_set_task_data(task, request, NULL);
+        loader->ref_count++;
+        g_task_run_in_thread(task, decode_thread);
+        g_object_unref(task);
+    }
+}
+
+// Decode everything on the calling thread (benchmarks and tools without a main loop)
+void asset_loader_run_sync(AssetLoader *loader) {
+    loader->start_time = g_get_monotonic_time();
+    resolve_packed(loader);
+    for (guint i = 0; i < loader->requests->len; i++) {
+        AssetRequest *request = g_ptr_array_index(loader->requests, i);
+        if (request->pixbuf) continue;
+        request->pixbuf = decode_request(request);
+        loader->completed++;
+    }
+    loader->finish_time = g_get_monotonic_time();
+}
+
+gboolean asset_loader_is_done(AssetLoader *loader) {
+    return loader->completed == loader->requests->len;
+}
+
+guint asset_loader_get_completed(AssetLoader *loader) {
+    return loader->completed;
+}
+
+guint asset_loader_get_count(AssetLoader *loader) {
+    return loader->requests->len;
+}
+
+// How many requests the pack served (0 without a pack or before start)
+guint asset_loader_get_packed(AssetLoader *loader) {
+    return loader->packed;
+}
+
+// Wall time from start to the last finished request (so far, while still loading)
+gdouble asset_loader_get_elapsed_ms(AssetLoader *loader) {
+    gint64 end = asset_loader_is_done(loader) ? loader->finish_time : g_get_monotonic_time();
+    return (end - loader->start_time) / 1000.0;
+}
+
+// Decoded image of a slot (borrowed, valid until asset_loader_free); read it once the loader is done
+GdkPixbuf* asset_loader_get(AssetLoader *loader, guint slot) {
+    if (slot >= loader->requests->len) return NULL;
+    AssetRequest *request = g_ptr_array_index(loader->requests, slot);
+    return request->pixbuf;
+}
+
+/* Safe while decodes are still running: they are cancelled, their results
+   dropped, and the memory is released when the last one reports back */
+void asset_loader_free(AssetLoader *loader) {
+    if (!loader) return;
+    loader->cancelled = TRUE;
+    g_cancellable_cancel(loader->cancellable);
+    asset_loader_unref(loader);
+}
@@ -0,0 +1,165 @@
+#include "asset_pack.h"
+#include "byteorder.h"
+#include <string.h>
+
+GQuark asset_pack_error_quark(void) {
+    return g_quark_from_static_string("asset-pack-error-quark");
+}
+
+// Index entry i of a mapped pack; FALSE if it points outside the file or cairo could not use the rows in place
+static gboolean read_entry(const guint8 *data, gsize size, guint i, AssetPackEntry *entry) {
+    const guint8 *p = data + ASSET_PACK_HEADER_SIZE + (gsize)i * ASSET_PACK_ENTRY_SIZE;
+    memcpy(entry->name, p, ASSET_PACK_NAME_SIZE);
+    entry->width = get_u32(p + 40);
+    entry->height = get_u32(p + 44);
+    entry->stride = get_u32(p + 48);
+    entry->offset = get_u64(p + 56);
+    if (entry->name[ASSET_PACK_NAME_SIZE - 1] != '\0') return FALSE;
+    if (entry->width == 0 || entry->height == 0 || entry->width > G_MAXINT16 || entry->height > G_MAXINT16) return FALSE;
+    if (entry->stride != (guint32)cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, (gint)entry->width)) return FALSE;
+    if (entry->offset % ASSET_PACK_ALIGN != 0) return FALSE;
+    return entry->offset <= size && (guint64)entry->stride * entry->height <= size - entry->offset;
+}
+
+/* Map the file and validate the header and index; pixels are not touched
+   until a surface is drawn, so the OS pages in only the images in use */
+AssetPack* asset_pack_open(const gchar *path, GError **error) {
+    GMappedFile *file = g_mapped_file_new(path, FALSE, error);
+    if (!file) return NULL;
+
+    const guint8 *data = (const guint8 *)g_mapped_file_get_contents(file);
+    gsize size = g_mapped_file_get_length(file);
+    if (size < ASSET_PACK_HEADER_SIZE || memcmp(data, ASSET_PACK_MAGIC, 4) != 0 || get_u16(data + 4) != ASSET_PACK_VERSION) {
+        g_set_error(error, ASSET_PACK_ERROR, ASSET_PACK_ERROR_FORMAT, "%s is not a version %d asset pack", path, ASSET_PACK_VERSION);
+        g_mapped_file_unref(file);
+        return NULL;
+    }
+    // Written in the packer's native order: a mismatch means the pixel words are byte-swapped too
+    guint32 byte_order;
+    memcpy(&byte_order, data + 8, sizeof(byte_order));
+    if (byte_order != ASSET_PACK_BYTE_ORDER) {
+        g_set_error(error, ASSET_PACK_ERROR, ASSET_PACK_ERROR_FORMAT, "%s was packed on a machine with a different byte order", path);
+        g_mapped_file_unref(file);
+        return NULL;
+    }
+
+    guint count = get_u16(data + 6);
+    if (size < ASSET_PACK_HEADER_SIZE + (gsize)count * ASSET_PACK_ENTRY_SIZE) {
+        g_set_error(error, ASSET_PACK_ERROR, ASSET_PACK_ERROR_FORMAT, "%s: truncated index", path);
+        g_mapped_file_unref(file);
+        return NULL;
+    }
+    GArray *entries = g_array_sized_new(FALSE, FALSE, sizeof(AssetPackEntry), count);
+    for (guint i = 0; i < count; i++) {
+        AssetPackEntry entry;
+        if (!read_entry(data, size, i, &entry)) {
+            g_set_error(error, ASSET_PACK_ERROR, ASSET_PACK_ERROR_FORMAT, "%s: bad index entry %u", path, i);
+            g_array_free(entries, TRUE);
+            g_mapped_file_unref(file);
+            return NULL;
+        }
+        g_array_append_val(entries, entry);
+    }
+
+    AssetPack *pack = g_malloc0(sizeof(AssetPack));
+    pack->file = file;
+    pack->data = data;
+    pack->size = size;
+    pack->entries = entries;
+    return pack;
+}
+
+static const cairo_user_data_key_t mapping_key;
+
+/* Image surface over entry `index`'s mapped rows (no copy). The surface holds
+   its own reference on the mapping, so it stays valid after asset_pack_free.
+   The mapping is read-only: draw from the surface, never into it. */
+cairo_surface_t* asset_pack_create_surface(AssetPack *pack, guint index) {
+    g_return_val_if_fail(index < pack->entries->len, NULL);
+    const AssetPackEntry *entry = &g_array_index(pack->entries, AssetPackEntry, index);
+    cairo_surface_t *surface = cairo_image_surface_create_for_data((guchar *)pack->data + entry->offset, CAIRO_FORMAT_ARGB32,
+                                                                   (gint)entry->width, (gint)entry->height, (gint)entry->stride);
+    cairo_surface_set_user_data(surface, &mapping_key, g_mapped_file_ref(pack->file), (cairo_destroy_func_t)g_mapped_file_unref);
+    return surface;
+}
+
+void asset_pack_free(AssetPack *pack) {
+    if (!pack) return;
+    g_array_free(pack->entries, TRUE);
+    g_mapped_file_unref(pack->file);
+    g_free(pack);
+}
+
+AssetPackWriter* asset_pack_writer_new(void) {
+    AssetPackWriter *writer = g_malloc0(sizeof(AssetPackWriter));
+    writer->names = g_ptr_array_new_with_free_func(g_free);
+    writer->images = g_ptr_array_new_with_free_func((GDestroyNotify)cairo_surface_destroy);
+    return writer;
+}
+
+// Queue an ARGB32 image surface under a source file name (the writer takes a reference)
+void asset_pack_writer_add(AssetPackWriter *writer, const gchar *name, cairo_surface_t *image) {
+    g_return_if_fail(strlen(name) < ASSET_PACK_NAME_SIZE);
+    g_return_if_fail(cairo_image_surface_get_format(image) == CAIRO_FORMAT_ARGB32);
+    g_ptr_array_add(writer->names, g_strdup(name));
+    g_ptr_array_add(writer->images, cairo_surface_reference(image));
+}
+
+static gsize align_up(gsize n) {
+    return (n + ASSET_PACK_ALIGN - 1) / ASSET_PACK_ALIGN * ASSET_PACK_ALIGN;
+}
+
+// Write header, index and pixel rows (re-strided to cairo's ARGB32 stride) in one go
+gboolean asset_pack_writer_save(AssetPackWriter *writer, const gchar *path, GError **error) {
+    guint count = writer->images->len;
+    if (count > G_MAXUINT16) {
+        g_set_error(error, ASSET_PACK_ERROR, ASSET_PACK_ERROR_FORMAT, "%s: too many images (%u)", path, count);
+        return FALSE;
+    }
+    GByteArray *out = g_byte_array_new();
+    gsize index_end = ASSET_PACK_HEADER_SIZE + (gsize)count * ASSET_PACK_ENTRY_SIZE;
+    g_byte_array_set_size(out, align_up(index_end));
+    memset(out->data, 0, out->len);
+
+    guint32 byte_order = ASSET_PACK_BYTE_ORDER;
+    memcpy(out->data, ASSET_PACK_MAGIC, 4);
+    put_u16(out->data + 4, ASSET_PACK_VERSION);
+    put_u16(out->data + 6, (guint16)count);
+    memcpy(out->data + 8, &byte_order, sizeof(byte_order));
+
+    for (guint i = 0; i < count; i++) {
+        cairo_surface_t *image = g_ptr_array_index(writer->images, i);
+        cairo_surface_flush(image);
+        gint width = cairo_image_surface_get_width(image);
+        gint height = cairo_image_surface_get_height(image);
+        gint src_stride = cairo_image_surface_get_stride(image);
+        gint stride = cairo_format_stride_for_width(CAIRO_FORMAT_ARGB32, width);
+        const guchar *src = cairo_image_surface_get_data(image);
+        gsize offset = out->len;
+
+        guint8 *p = out->data + ASSET_PACK_HEADER_SIZE + (gsize)i * ASSET_PACK_ENTRY_SIZE;
+        strncpy((gchar *)p, g_ptr_array_index(writer->names, i), ASSET_PACK_NAME_SIZE - 1);
+        put_u32(p + 40, (guint32)width);
+        put_u32(p + 44, (guint32)height);
+        put_u32(p + 48, (guint32)stride);
+        put_u32(p + 52, 0);
+        put_u64(p + 56, offset);
+
+        g_byte_array_set_size(out, align_up(offset + (gsize)stride * height));
+        memset(out->data + offset, 0, out->len - offset);
+        for (gint y = 0; y < height; y++) {
+            memcpy(out->data + offset + (gsize)y * stride, src + (gsize)y * src_stride, (gsize)width * 4);
+        }
+    }
+
+    gboolean ok = g_file_set_contents(path, (const gchar *)out->data, out->len, error);
+    g_byte_array_free(out, TRUE);
+    return ok;
+}
+
+void asset_pack_writer_free(AssetPackWriter *writer) {
+    if (!writer) return;
+    g_ptr_array_free(writer->names, TRUE);
+    g_ptr_array_free(writer->images, TRUE);
+    g_free(writer);
+}
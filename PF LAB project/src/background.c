@@ -0,0 +1,76 @@
+#include "background.h"
+#include "graphics.h"
+#include <math.h>
+
+ScrollingBackground* background_new(gint width, gint height) {
+    ScrollingBackground *background = g_malloc(sizeof(ScrollingBackground));
+    background->layers = g_ptr_array_new();
+    background->width = width;
+    background->height = height;
+    return background;
+}
+
+/* Decode/scale/premultiply once per render scale (a packed image at 1x or 2x
+   already is); every frame in between is a plain blit */
+static gboolean background_layer_build(ScrollingBackground *background, BackgroundLayer *layer, gdouble scale) {
+    cairo_surface_t *surface = graphics_image_surface_for_pixbuf_scaled(layer->image, background->width, background->height, scale);
+    if (!surface) return FALSE;
+    if (layer->pattern) cairo_pattern_destroy(layer->pattern);
+    if (layer->surface) cairo_surface_destroy(layer->surface);
+    layer->surface = surface;
+    layer->pattern = cairo_pattern_create_for_surface(layer->surface);
+    cairo_pattern_set_extend(layer->pattern, CAIRO_EXTEND_REPEAT);
+    layer->scale = scale;
+    return TRUE;
+}
+
+void background_add_layer(ScrollingBackground *background, GdkPixbuf *image, gdouble speed_factor) {
+    if (!background || !image) return;
+
+    BackgroundLayer *layer = g_malloc0(sizeof(BackgroundLayer));
+    layer->image = g_object_ref(image);
+    layer->speed_factor = speed_factor;
+    if (!background_layer_build(background, layer, 1.0)) {
+        g_object_unref(layer->image);
+        g_free(layer);
+        return;
+    }
+
+    g_ptr_array_add(background->layers, layer);
+}
+
+void background_draw(ScrollingBackground *background, cairo_t *cr, gdouble scroll) {
+    if (!background) return;
+
+    gdouble scale = graphics_get_scale(cr);
+    for (guint i = 0; i < background->layers->len; i++) {
+        BackgroundLayer *layer = g_ptr_array_index(background->layers, i);
+        if (layer->scale != scale) background_layer_build(background, layer, scale);
+
+        /* Wrap the offset into one tile height and keep it on whole device
+           pixels so the repeat pattern stays on pixman's untransformed fast path. */
+        gdouble y = fmod(scroll * layer->speed_factor, (gdouble)background->height);
+        if (y < 0) y += background->height;
+
+        cairo_matrix_t matrix;
+        cairo_matrix_init_translate(&matrix, 0, -floor(y * scale) / scale);
+        cairo_pattern_set_matrix(layer->pattern, &matrix);
+
+        cairo_set_source(cr, layer->pattern);
+        cairo_rectangle(cr, 0, 0, background->width, background->height);
+        cairo_fill(cr);
+    }
+}
+
+void background_free(ScrollingBackground *background) {
+    if (!background) return;
+    for (guint i = 0; i < background->layers->len; i++) {
+        BackgroundLayer *layer = g_ptr_array_index(background->layers, i);
+        cairo_pattern_destroy(layer->pattern);
+        cairo_surface_destroy(layer->surface);
+        g_object_unref(layer->image);
+        g_free(layer);
+    }
+    g_ptr_array_free(background->layers, TRUE);
+    g_free(background);
+}
@@ -0,0 +1,267 @@
+#include "collision.h"
+#include <string.h>
+
+// Rectangle collision test on inset hitboxes (narrow phase)
+gboolean check_collision(gdouble x1, gdouble y1, gdouble w1, gdouble h1,
+                         gdouble x2, gdouble y2, gdouble w2, gdouble h2) {
+    /* Shrink hitboxes slightly to make collisions feel fair and avoid early triggers.
+       We inset each box by INSET_RATIO of its size. */
+    const gdouble INSET_RATIO = COLLISION_INSET_RATIO; /* 12% inset */
+    gdouble ix1 = w1 * INSET_RATIO;
+    gdouble iy1 = h1 * INSET_RATIO;
+    gdouble ix2 = w2 * INSET_RATIO;
+    gdouble iy2 = h2 * INSET_RATIO;
+
+    gdouble nx1 = x1 + ix1 * 0.5;
+    gdouble ny1 = y1 + iy1 * 0.5;
+    gdouble nw1 = w1 - ix1;
+    gdouble nh1 = h1 - iy1;
+
+    gdouble nx2 = x2 + ix2 * 0.5;
+    gdouble ny2 = y2 + iy2 * 0.5;
+    gdouble nw2 = w2 - ix2;
+    gdouble nh2 = h2 - iy2;
+
+    if (nw1 <= 0 || nh1 <= 0 || nw2 <= 0 || nh2 <= 0) {
+        /* Fallback to original sizes if inset would eliminate boxes */
+        return !(x1 + w1 < x2 || x2 + w2 < x1 || y1 + h1 < y2 || y2 + h2 < y1);
+    }
+
+    return !(nx1 + nw1 < nx2 || nx2 + nw2 < nx1 || ny1 + nh1 < ny2 || ny2 + nh2 < ny1);
+}
+
+/* ============================================================================
+   BATCHED COLLISION KERNELS
+
+   The box side is inset once; each obstacle lane then follows exactly the
+   same operations as check_collision (no fused multiply-add, ordered
+   compares), so every kernel returns the same bits as the scalar function.
+   Kernels write one bit per obstacle into 64-bit mask words.
+   ============================================================================ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COLLISION_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+typedef void (*CollisionMaskFunc)(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                                  const gdouble *w, const gdouble *h, guint count, guint64 *mask);
+
+void collision_box_init(CollisionBox *box, gdouble x, gdouble y, gdouble w, gdouble h) {
+    const gdouble INSET_RATIO = COLLISION_INSET_RATIO;
+    gdouble ix = w * INSET_RATIO;
+    gdouble iy = h * INSET_RATIO;
+    gdouble nw = w - ix;
+    gdouble nh = h - iy;
+
+    box->x = x;
+    box->y = y;
+    box->w = w;
+    box->h = h;
+    box->nx = x + ix * 0.5;
+    box->ny = y + iy * 0.5;
+    box->nx_end = box->nx + nw;
+    box->ny_end = box->ny + nh;
+    box->inset_valid = !(nw <= 0 || nh <= 0);
+}
+
+gboolean collision_box_test(const CollisionBox *box, gdouble x2, gdouble y2, gdouble w2, gdouble h2) {
+    const gdouble INSET_RATIO = COLLISION_INSET_RATIO;
+    gdouble ix2 = w2 * INSET_RATIO;
+    gdouble iy2 = h2 * INSET_RATIO;
+    gdouble nx2 = x2 + ix2 * 0.5;
+    gdouble ny2 = y2 + iy2 * 0.5;
+    gdouble nw2 = w2 - ix2;
+    gdouble nh2 = h2 - iy2;
+
+    if (!box->inset_valid || nw2 <= 0 || nh2 <= 0) {
+        return !(box->x + box->w < x2 || x2 + w2 < box->x || box->y + box->h < y2 || y2 + h2 < box->y);
+    }
+    return !(box->nx_end < nx2 || nx2 + nw2 < box->nx || box->ny_end < ny2 || ny2 + nh2 < box->ny);
+}
+
+static void hit_mask_scalar(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                            const gdouble *w, const gdouble *h, guint count, guint64 *mask) {
+    memset(mask, 0, ((count + 63) / 64) * sizeof(guint64));
+    for (guint i = 0; i < count; i++) {
+        if (collision_box_test(box, x[i], y[i], w[i], h[i])) {
+            mask[i / 64] |= G_GUINT64_CONSTANT(1) << (i % 64);
+        }
+    }
+}
+
+#ifdef COLLISION_HAVE_X86
+
+/* Lane-wise collision_box_test for two boxes; returns a 2-bit hit mask */
+__attribute__((target("sse2")))
+static inline gint hit_pair_sse2(const CollisionBox *box, __m128d ratio, __m128d half, __m128d zero,
+                                 __m128d x2, __m128d y2, __m128d w2, __m128d h2) {
+    __m128d ix2 = _mm_mul_pd(w2, ratio);
+    __m128d iy2 = _mm_mul_pd(h2, ratio);
+    __m128d nx2 = _mm_add_pd(x2, _mm_mul_pd(ix2, half));
+    __m128d ny2 = _mm_add_pd(y2, _mm_mul_pd(iy2, half));
+    __m128d nw2 = _mm_sub_pd(w2, ix2);
+    __m128d nh2 = _mm_sub_pd(h2, iy2);
+
+    __m128d fallback = _mm_or_pd(_mm_cmple_pd(nw2, zero), _mm_cmple_pd(nh2, zero));
+    if (!box->inset_valid) fallback = _mm_cmpeq_pd(zero, zero);
+
+    __m128d inset_miss = _mm_or_pd(
+        _mm_or_pd(_mm_cmplt_pd(_mm_set1_pd(box->nx_end), nx2), _mm_cmplt_pd(_mm_add_pd(nx2, nw2), _mm_set1_pd(box->nx))),
+        _mm_or_pd(_mm_cmplt_pd(_mm_set1_pd(box->ny_end), ny2), _mm_cmplt_pd(_mm_add_pd(ny2, nh2), _mm_set1_pd(box->ny))));
+    __m128d raw_miss = _mm_or_pd(
+        _mm_or_pd(_mm_cmplt_pd(_mm_set1_pd(box->x + box->w), x2), _mm_cmplt_pd(_mm_add_pd(x2, w2), _mm_set1_pd(box->x))),
+        _mm_or_pd(_mm_cmplt_pd(_mm_set1_pd(box->y + box->h), y2), _mm_cmplt_pd(_mm_add_pd(y2, h2), _mm_set1_pd(box->y))));
+
+    __m128d miss = _mm_or_pd(_mm_and_pd(fallback, raw_miss), _mm_andnot_pd(fallback, inset_miss));
+    return _mm_movemask_pd(miss) ^ 0x3;
+}
+
+__attribute__((target("sse2")))
+static void hit_mask_sse2(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                          const gdouble *w, const gdouble *h, guint count, guint64 *mask) {
+    const __m128d ratio = _mm_set1_pd(COLLISION_INSET_RATIO);
+    const __m128d half = _mm_set1_pd(0.5);
+    const __m128d zero = _mm_setzero_pd();
+    guint i = 0;
+
+    memset(mask, 0, ((count + 63) / 64) * sizeof(guint64));
+    for (; i + 4 <= count; i += 4) {
+        gint lo = hit_pair_sse2(box, ratio, half, zero, _mm_loadu_pd(x + i), _mm_loadu_pd(y + i),
+                                _mm_loadu_pd(w + i), _mm_loadu_pd(h + i));
+        gint hi = hit_pair_sse2(box, ratio, half, zero, _mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2),
+                                _mm_loadu_pd(w + i + 2), _mm_loadu_pd(h + i + 2));
+        mask[i / 64] |= (guint64)(lo | (hi << 2)) << (i % 64);
+    }
+    for (; i < count; i++) {
+        if (collision_box_test(box, x[i], y[i], w[i], h[i])) {
+            mask[i / 64] |= G_GUINT64_CONSTANT(1) << (i % 64);
+        }
+    }
+}
+
+/* Lane-wise collision_box_test for four boxes; returns a 4-bit hit mask */
+__attribute__((target("avx2")))
+static inline gint hit_quad_avx2(const CollisionBox *box, __m256d ratio, __m256d half, __m256d zero,
+                                 __m256d x2, __m256d y2, __m256d w2, __m256d h2) {
+    __m256d ix2 = _mm256_mul_pd(w2, ratio);
+    __m256d iy2 = _mm256_mul_pd(h2, ratio);
+    __m256d nx2 = _mm256_add_pd(x2, _mm256_mul_pd(ix2, half));
+    __m256d ny2 = _mm256_add_pd(y2, _mm256_mul_pd(iy2, half));
+    __m256d nw2 = _mm256_sub_pd(w2, ix2);
+    __m256d nh2 = _mm256_sub_pd(h2, iy2);
+
+    __m256d fallback = _mm256_or_pd(_mm256_cmp_pd(nw2, zero, _CMP_LE_OQ), _mm256_cmp_pd(nh2, zero, _CMP_LE_OQ));
+    if (!box->inset_valid) fallback = _mm256_cmp_pd(zero, zero, _CMP_EQ_OQ);
+
+    __m256d inset_miss = _mm256_or_pd(
+        _mm256_or_pd(_mm256_cmp_pd(_mm256_set1_pd(box->nx_end), nx2, _CMP_LT_OQ),
+                     _mm256_cmp_pd(_mm256_add_pd(nx2, nw2), _mm256_set1_pd(box->nx), _CMP_LT_OQ)),
+        _mm256_or_pd(_mm256_cmp_pd(_mm256_set1_pd(box->ny_end), ny2, _CMP_LT_OQ),
+                     _mm256_cmp_pd(_mm256_add_pd(ny2, nh2), _mm256_set1_pd(box->ny), _CMP_LT_OQ)));
+    __m256d raw_miss = _mm256_or_pd(
+        _mm256_or_pd(_mm256_cmp_pd(_mm256_set1_pd(box->x + box->w), x2, _CMP_LT_OQ),
+                     _mm256_cmp_pd(_mm256_add_pd(x2, w2), _mm256_set1_pd(box->x), _CMP_LT_OQ)),
+        _mm256_or_pd(_mm256_cmp_pd(_mm256_set1_pd(box->y + box->h), y2, _CMP_LT_OQ),
+                     _mm256_cmp_pd(_mm256_add_pd(y2, h2), _mm256_set1_pd(box->y), _CMP_LT_OQ)));
+
+    __m256d miss = _mm256_blendv_pd(inset_miss, raw_miss, fallback);
+    return _mm256_movemask_pd(miss) ^ 0xF;
+}
+
+__attribute__((target("avx2")))
+static void hit_mask_avx2(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                          const gdouble *w, const gdouble *h, guint count, guint64 *mask) {
+    const __m256d ratio = _mm256_set1_pd(COLLISION_INSET_RATIO);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d zero = _mm256_setzero_pd();
+    guint i = 0;
+
+    memset(mask, 0, ((count + 63) / 64) * sizeof(guint64));
+    for (; i + 8 <= count; i += 8) {
+        gint lo = hit_quad_avx2(box, ratio, half, zero, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i),
+                                _mm256_loadu_pd(w + i), _mm256_loadu_pd(h + i));
+        gint hi = hit_quad_avx2(box, ratio, half, zero, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4),
+                                _mm256_loadu_pd(w + i + 4), _mm256_loadu_pd(h + i + 4));
+        mask[i / 64] |= (guint64)(lo | (hi << 4)) << (i % 64);
+    }
+    for (; i < count; i++) {
+        if (collision_box_test(box, x[i], y[i], w[i], h[i])) {
+            mask[i / 64] |= G_GUINT64_CONSTANT(1) << (i % 64);
+        }
+    }
+}
+
+#endif /* COLLISION_HAVE_X86 */
+
+static CollisionKernel active_kernel = COLLISION_KERNEL_AUTO;
+static CollisionMaskFunc active_mask_func = NULL;
+
+static gboolean kernel_supported(CollisionKernel kernel) {
+    switch (kernel) {
+        case COLLISION_KERNEL_SCALAR:
+            return TRUE;
+#ifdef COLLISION_HAVE_X86
+        case COLLISION_KERNEL_SSE2:
+            return __builtin_cpu_supports("sse2");
+        case COLLISION_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return FALSE;
+    }
+}
+
+// Select a kernel; AUTO picks the widest one the CPU supports. FALSE if unsupported.
+gboolean collision_set_kernel(CollisionKernel kernel) {
+    if (kernel == COLLISION_KERNEL_AUTO) {
+        if (kernel_supported(COLLISION_KERNEL_AVX2)) kernel = COLLISION_KERNEL_AVX2;
+        else if (kernel_supported(COLLISION_KERNEL_SSE2)) kernel = COLLISION_KERNEL_SSE2;
+        else kernel = COLLISION_KERNEL_SCALAR;
+    }
+    if (!kernel_supported(kernel)) return FALSE;
+
+    switch (kernel) {
+#ifdef COLLISION_HAVE_X86
+        case COLLISION_KERNEL_SSE2: active_mask_func = hit_mask_sse2; break;
+        case COLLISION_KERNEL_AVX2: active_mask_func = hit_mask_avx2; break;
+#endif
+        default: active_mask_func = hit_mask_scalar; break;
+    }
+    active_kernel = kernel;
+    return TRUE;
+}
+
+CollisionKernel collision_get_kernel(void) {
+    if (!active_mask_func) collision_set_kernel(COLLISION_KERNEL_AUTO);
+    return active_kernel;
+}
+
+const gchar* collision_kernel_name(CollisionKernel kernel) {
+    switch (kernel) {
+        case COLLISION_KERNEL_SCALAR: return "scalar";
+        case COLLISION_KERNEL_SSE2: return "sse2";
+        case COLLISION_KERNEL_AVX2: return "avx2";
+        default: return "auto";
+    }
+}
+
+// Set bit i of mask (ceil(count / 64) words) when box hits box i
+void collision_hit_mask(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                        const gdouble *w, const gdouble *h, guint count, guint64 *mask) {
+    if (!active_mask_func) collision_set_kernel(COLLISION_KERNEL_AUTO);
+    active_mask_func(box, x, y, w, h, count, mask);
+}
+
+// Index of the first box hit, or -1. Works in 64-box chunks so the mask fits on the stack.
+gint collision_first_hit(const CollisionBox *box, const gdouble *x, const gdouble *y,
+                         const gdouble *w, const gdouble *h, guint count) {
+    if (!active_mask_func) collision_set_kernel(COLLISION_KERNEL_AUTO);
+    for (guint base = 0; base < count; base += 64) {
+        guint64 mask = 0;
+        guint n = MIN(64, count - base);
+        active_mask_func(box, x + base, y + base, w + base, h + base, n, &mask);
+        if (mask) return (gint)(base + __builtin_ctzll(mask));
+    }
+    return -1;
+}
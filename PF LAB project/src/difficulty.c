@@ -0,0 +1,258 @@
+#include "difficulty.h"
+#include "trace.h"
+#include <math.h>
+#include <stddef.h>
+
+/* Default curve (see DifficultyParams for the formulas) */
+#define DIFFICULTY_K_SPEED 2000.0  /* Exponent divisor for speed scaling */
+#define DIFFICULTY_K_SPAWN 1500.0  /* Exponent divisor for spawn scaling */
+#define MAX_SPEED_MULT 3.0         /* Cap speed at 3x base */
+#define MIN_SPAWN_INTERVAL 0.3     /* Minimum spawn interval to prevent impossibility */
+#define SPEED_EXPONENT 1.5
+#define SPAWN_EXPONENT 1.2
+#define SCORE_SCALE 3000.0
+#define SCORE_EXPONENT 0.8
+#define MAX_SCORE_MULT 4.0
+
+/* Difficulty stages: score thresholds for stage transitions */
+#define STAGE_1_EASY_MAX 500
+#define STAGE_2_MEDIUM_MAX 1500
+#define STAGE_3_HARD_MAX 3000
+#define STAGE_4_VERYHARD_MAX 5000
+/* Stage 5 (Extreme) is everything above 5000 */
+
+GQuark difficulty_error_quark(void) {
+    return g_quark_from_static_string("difficulty-error-quark");
+}
+
+void difficulty_params_defaults(DifficultyParams *params) {
+    params->k_speed = DIFFICULTY_K_SPEED;
+    params->k_spawn = DIFFICULTY_K_SPAWN;
+    params->max_speed_mult = MAX_SPEED_MULT;
+    params->min_spawn_interval = MIN_SPAWN_INTERVAL;
+    params->speed_exponent = SPEED_EXPONENT;
+    params->spawn_exponent = SPAWN_EXPONENT;
+    params->score_scale = SCORE_SCALE;
+    params->score_exponent = SCORE_EXPONENT;
+    params->max_score_mult = MAX_SCORE_MULT;
+    params->stage_max[0] = STAGE_1_EASY_MAX;
+    params->stage_max[1] = STAGE_2_MEDIUM_MAX;
+    params->stage_max[2] = STAGE_3_HARD_MAX;
+    params->stage_max[3] = STAGE_4_VERYHARD_MAX;
+}
+
+// Finite and > 0 (NaN and infinity fail)
+static gboolean positive(gdouble value) {
+    return isfinite(value) && value > 0.0;
+}
+
+/* Every curve must be monotonic towards its cap, which is what lets a table
+   stop at the cap; a NaN would never reach it and fill the whole table */
+gboolean difficulty_params_validate(const DifficultyParams *params, GError **error) {
+    if (!positive(params->k_speed) || !positive(params->k_spawn) || !positive(params->score_scale)) {
+        g_set_error(error, DIFFICULTY_ERROR, DIFFICULTY_ERROR_INVALID, "k_speed, k_spawn and score_scale must be positive and finite");
+        return FALSE;
+    }
+    if (!positive(params->speed_exponent) || !positive(params->spawn_exponent) || !positive(params->score_exponent)) {
+        g_set_error(error, DIFFICULTY_ERROR, DIFFICULTY_ERROR_INVALID, "speed_exponent, spawn_exponent and score_exponent must be positive and finite");
+        return FALSE;
+    }
+    if (!positive(params->min_spawn_interval) || !positive(params->max_speed_mult) || !positive(params->max_score_mult)) {
+        g_set_error(error, DIFFICULTY_ERROR, DIFFICULTY_ERROR_INVALID, "min_spawn_interval, max_speed_mult and max_score_mult must be positive and finite");
+        return FALSE;
+    }
+    for (guint s = 0; s < G_N_ELEMENTS(params->stage_max); s++) {
+        if (params->stage_max[s] < 0 || (s > 0 && params->stage_max[s] <= params->stage_max[s - 1])) {
+            g_set_error(error, DIFFICULTY_ERROR, DIFFICULTY_ERROR_INVALID, "stage_thresholds must be non-negative and ascending");
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static const struct {
+    const gchar *key;
+    gsize offset;
+} double_keys[] = {
+    {"k_speed", offsetof(DifficultyParams, k_speed)},
+    {"k_spawn", offsetof(DifficultyParams, k_spawn)},
+    {"max_speed_mult", offsetof(DifficultyParams, max_speed_mult)},
+    {"min_spawn_interval", offsetof(DifficultyParams, min_spawn_interval)},
+    {"speed_exponent", offsetof(DifficultyParams, speed_exponent)},
+    {"spawn_exponent", offsetof(DifficultyParams, spawn_exponent)},
+    {"score_scale", offsetof(DifficultyParams, score_scale)},
+    {"score_exponent", offsetof(DifficultyParams, score_exponent)},
+    {"max_score_mult", offsetof(DifficultyParams, max_score_mult)},
+};
+
+/* Override params with the keys present in one group of a key file
+   (stage_thresholds is a ;-separated list of up to four scores), then
+   validate. params is left untouched on error. */
+gboolean difficulty_params_load(DifficultyParams *params, GKeyFile *file, const gchar *group, GError **error) {
+    DifficultyParams loaded = *params;
+    for (guint i = 0; i < G_N_ELEMENTS(double_keys); i++) {
+        if (!g_key_file_has_key(file, group, double_keys[i].key, NULL)) continue;
+        GError *key_error = NULL;
+        gdouble value = g_key_file_get_double(file, group, double_keys[i].key, &key_error);
+        if (key_error) {
+            g_propagate_prefixed_error(error, key_error, "[%s] %s: ", group, double_keys[i].key);
+            return FALSE;
+        }
+        *(gdouble *)((guint8 *)&loaded + double_keys[i].offset) = value;
+    }
+    if (g_key_file_has_key(file, group, "stage_thresholds", NULL)) {
+        gsize n = 0;
+        gint *stages = g_key_file_get_integer_list(file, group, "stage_thresholds", &n, error);
+        if (!stages) return FALSE;
+        for (gsize s = 0; s < n && s < G_N_ELEMENTS(loaded.stage_max); s++) loaded.stage_max[s] = stages[s];
+        g_free(stages);
+    }
+    if (!difficulty_params_validate(&loaded, error)) {
+        g_prefix_error(error, "[%s]: ", group);
+        return FALSE;
+    }
+    *params = loaded;
+    return TRUE;
+}
+
+// Load one group of an ini file over params (group NULL = the first group in the file)
+gboolean difficulty_params_load_file(DifficultyParams *params, const gchar *path, const gchar *group, GError **error) {
+    GKeyFile *file = g_key_file_new();
+    if (!g_key_file_load_from_file(file, path, G_KEY_FILE_NONE, error)) {
+        g_key_file_free(file);
+        return FALSE;
+    }
+    gchar *start = g_key_file_get_start_group(file);
+    const gchar *name = group ? group : start;
+    gboolean ok;
+    if (!name || !g_key_file_has_group(file, name)) {
+        g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_GROUP_NOT_FOUND, "%s has no group %s", path, name ? name : "");
+        ok = FALSE;
+    } else {
+        ok = difficulty_params_load(params, file, name, error);
+    }
+    g_free(start);
+    g_key_file_free(file);
+    return ok;
+}
+
+// Stage from the thresholds: at most four integer compares, not worth a table
+static gint stage_for_score(const DifficultyParams *params, gint score) {
+    gint stage = 1;
+    while (stage < DIFFICULTY_STAGE_COUNT && score >= params->stage_max[stage - 1]) {
+        stage++;
+    }
+    return stage;
+}
+
+/* Reference formulas: exponential speed and spawn ramps and a rising score
+   bonus, each clamped to its cap, plus the stage from the thresholds */
+void difficulty_evaluate(const DifficultyParams *params, gint score, DifficultyLevel *out) {
+    gdouble score_norm = (gdouble)score;
+
+    /* Exponential speed multiplier: base_speed * (1 + score/k_speed)^1.5
+       This makes speed increase noticeably but controllably. */
+    gdouble speed_factor = 1.0 + (score_norm / params->k_speed);
+    out->speed_multiplier = pow(speed_factor, params->speed_exponent);
+    if (out->speed_multiplier > params->max_speed_mult) {
+        out->speed_multiplier = params->max_speed_mult;
+    }
+
+    /* Exponential spawn rate: base_interval / (1 + score/k_spawn)^1.2
+       Smaller interval = more frequent spawns. */
+    gdouble spawn_factor = 1.0 + (score_norm / params->k_spawn);
+    out->spawn_multiplier = 1.0 / pow(spawn_factor, params->spawn_exponent);
+    if (out->spawn_multiplier < (params->min_spawn_interval / DIFFICULTY_BASE_SPAWN_INTERVAL)) {
+        out->spawn_multiplier = params->min_spawn_interval / DIFFICULTY_BASE_SPAWN_INTERVAL;
+    }
+
+    /* Score multiplier: increases rewards as difficulty rises
+       multiplier = 1.0 + (score / 3000.0)^0.8, capped at reasonable value */
+    gdouble mult_factor = 1.0 + pow(score_norm / params->score_scale, params->score_exponent);
+    if (mult_factor > params->max_score_mult) mult_factor = params->max_score_mult;
+    out->score_multiplier = mult_factor;
+
+    out->stage = stage_for_score(params, score);
+}
+
+static void curve_finish(DifficultyCurve *curve, GArray *values, gboolean saturated) {
+    curve->length = values->len;
+    curve->saturated = saturated;
+    curve->values = (gdouble *)g_array_free(values, FALSE);
+}
+
+/* Sample all three curves at every score from 0 until each sits at its cap
+   (then it stays there) or DIFFICULTY_TABLE_MAX_POINTS is reached */
+DifficultyTable* difficulty_table_new(const DifficultyParams *params) {
+    TRACE_BEGIN(trace, "difficulty_table_new");
+    DifficultyTable *table = g_malloc0(sizeof(DifficultyTable));
+    table->params = *params;
+    table->ref_count = 1;
+
+    gdouble min_spawn = params->min_spawn_interval / DIFFICULTY_BASE_SPAWN_INTERVAL;
+    GArray *speed = g_array_new(FALSE, FALSE, sizeof(gdouble));
+    GArray *spawn = g_array_new(FALSE, FALSE, sizeof(gdouble));
+    GArray *score = g_array_new(FALSE, FALSE, sizeof(gdouble));
+    gboolean speed_done = FALSE, spawn_done = FALSE, score_done = FALSE;
+    for (gint s = 0; s < DIFFICULTY_TABLE_MAX_POINTS && !(speed_done && spawn_done && score_done); s++) {
+        DifficultyLevel level;
+        difficulty_evaluate(params, s, &level);
+        if (!speed_done) {
+            g_array_append_val(speed, level.speed_multiplier);
+            speed_done = level.speed_multiplier == params->max_speed_mult;
+        }
+        if (!spawn_done) {
+            g_array_append_val(spawn, level.spawn_multiplier);
+            spawn_done = level.spawn_multiplier == min_spawn;
+        }
+        if (!score_done) {
+            g_array_append_val(score, level.score_multiplier);
+            score_done = level.score_multiplier == params->max_score_mult;
+        }
+    }
+    curve_finish(&table->speed, speed, speed_done);
+    curve_finish(&table->spawn, spawn, spawn_done);
+    curve_finish(&table->score, score, score_done);
+    TRACE_END(trace);
+    return table;
+}
+
+// Safe from any thread
+DifficultyTable* difficulty_table_ref(DifficultyTable *table) {
+    g_atomic_int_inc(&table->ref_count);
+    return table;
+}
+
+void difficulty_table_unref(DifficultyTable *table) {
+    if (!table || !g_atomic_int_dec_and_test(&table->ref_count)) return;
+    g_free(table->speed.values);
+    g_free(table->spawn.values);
+    g_free(table->score.values);
+    g_free(table);
+}
+
+// Curve value at score; FALSE past the end of a curve that never saturated
+static inline gboolean curve_lookup(const DifficultyCurve *curve, gint score, gdouble *value) {
+    if ((guint)score < curve->length) {
+        *value = curve->values[score];
+        return TRUE;
+    }
+    if (curve->saturated) {
+        *value = curve->values[curve->length - 1];
+        return TRUE;
+    }
+    return FALSE;
+}
+
+// Same values as difficulty_evaluate(&table->params, score, out), without the pow() calls
+void difficulty_table_lookup(const DifficultyTable *table, gint score, DifficultyLevel *out) {
+    if (score < 0) score = 0;
+    gboolean hit = curve_lookup(&table->speed, score, &out->speed_multiplier);
+    hit &= curve_lookup(&table->spawn, score, &out->spawn_multiplier);
+    hit &= curve_lookup(&table->score, score, &out->score_multiplier);
+    if (!hit) {
+        difficulty_evaluate(&table->params, score, out);
+        return;
+    }
+    out->stage = stage_for_score(&table->params, score);
+}
@@ -0,0 +1,339 @@
+/* Monte Carlo difficulty-curve evaluator (headless, links libcarsim.a only).
+
+   Plays thousands of simulated games per DifficultyParams set with a bot
+   driver on every core (work-stealing pool) and reports survival-time
+   distributions, score percentiles and how often each difficulty stage is
+   reached. Game i of every set uses seed (--seed + i), so sets are compared
+   on the same obstacle streams and results do not depend on thread count.
+
+   Usage: difficulty_eval [options] [params.ini]
+     --games=N        games per parameter set (default 2000)
+     --threads=N      worker threads (default: all cores)
+     --bot=NAME       dodge (default), random or idle
+     --max-seconds=S  cut a game off after S simulated seconds (default 300)
+     --seed=N         first seed (default 1)
+     --scaling        time the first set with 1, 2, 4, ... threads
+
+   params.ini holds one group per parameter set; missing keys keep the
+   built-in values (the game reads the same format with --difficulty=FILE):
+     [baseline]
+     k_speed=2000
+     k_spawn=1500
+     max_speed_mult=3.0
+     min_spawn_interval=0.3
+     speed_exponent=1.5
+     spawn_exponent=1.2
+     score_scale=3000
+     score_exponent=0.8
+     max_score_mult=4.0
+     stage_thresholds=500;1500;3000;5000 */
+#include <glib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "sim.h"
+#include "compare.h"
+#include "rng.h"
+#include "work_pool.h"
+
+#define EVAL_TICK_RATE 60.0
+#define HISTOGRAM_BUCKET_SECONDS 10.0
+#define HISTOGRAM_BUCKETS 12          // last bucket collects everything longer
+#define DODGE_LANE_STEP 20.0          // px between candidate lanes
+#define DODGE_HORIZON 1.5             // seconds of lookahead
+#define DODGE_MARGIN 6.0              // px kept clear either side of the car
+
+typedef enum {
+    BOT_DODGE,
+    BOT_RANDOM,
+    BOT_IDLE
+} BotKind;
+
+typedef struct {
+    gchar *name;
+    DifficultyParams params;
+    DifficultyTable *table;     // built once, shared by every worker's context
+} ParamSet;
+
+typedef struct {
+    guint64 ticks;
+    gint score;
+    gint stage;
+    gboolean timed_out;
+} GameResult;
+
+typedef struct {
+    const ParamSet *set;
+    BotKind bot;
+    guint64 first_seed;
+    guint64 max_ticks;
+    SimContext **sims;      // one per worker
+    GameResult *results;    // one per game
+} EvalJob;
+
+/* Arcade-mode lane picker: score candidate x positions by how soon an
+   obstacle falling through that lane reaches the car, plus a small travel
+   cost, and steer towards the cheapest one. */
+static guint dodge_input(const SimContext *sim) {
+    const Player *player = sim->player;
+    const ObstaclePool *pool = &sim->obstacles->pool;
+    gdouble px = player->x + player->width / 2.0;
+    gdouble half = player->width / 2.0 + DODGE_MARGIN;
+    gdouble best_x = px;
+    gdouble best_cost = G_MAXDOUBLE;
+
+    for (gdouble cx = half; cx <= GAME_WIDTH - half; cx += DODGE_LANE_STEP) {
+        gdouble cost = fabs(cx - px) * 0.002;
+        for (guint i = 0; i < pool->count; i++) {
+            if (pool->x[i] + pool->w[i] < cx - half || pool->x[i] > cx + half) continue;
+            if (pool->y[i] > player->y + player->height) continue; /* already past */
+            gdouble t = (player->y - (pool->y[i] + pool->h[i])) / pool->vel[i];
+            if (t > DODGE_HORIZON) continue;
+            cost += 1.0 / (MAX(t, 0.0) + 0.05);
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_x = cx;
+        }
+    }
+
+    if (best_x < px - 4.0) return SIM_INPUT_LEFT;
+    if (best_x > px + 4.0) return SIM_INPUT_RIGHT;
+    return 0;
+}
+
+static void play_game(guint index, guint worker, gpointer user_data) {
+    EvalJob *job = user_data;
+    SimContext *sim = job->sims[worker];
+    guint64 seed = job->first_seed + index;
+    const gdouble dt = 1.0 / EVAL_TICK_RATE;
+    Rng policy;
+    rng_seed(&policy, seed, 3);
+
+    sim_set_difficulty_table(sim, job->set->table);
+    sim_set_arcade_mode(sim, job->bot == BOT_DODGE);
+    sim_set_seed(sim, seed);
+    sim_reset(sim);
+
+    guint input = 0;
+    while (!sim_is_over(sim) && sim_get_tick(sim) < job->max_ticks) {
+        switch (job->bot) {
+            case BOT_DODGE:
+                input = dodge_input(sim);
+                break;
+            case BOT_RANDOM:
+                if (sim_get_tick(sim) % 12 == 0) input = rng_range(&policy, 16);
+                break;
+            case BOT_IDLE:
+                input = 0;
+                break;
+        }
+        sim_step(sim, input, dt);
+    }
+
+    GameResult *result = &job->results[index];
+    result->ticks = sim_get_tick(sim);
+    result->score = sim_get_score(sim);
+    result->stage = sim->difficulty_stage;
+    result->timed_out = !sim_is_over(sim);
+}
+
+// Nearest-rank percentile of sorted values
+static gdouble percentile(const gdouble *sorted, guint n, gdouble p) {
+    guint rank = (guint)ceil(p / 100.0 * n);
+    return sorted[CLAMP(rank, 1, n) - 1];
+}
+
+static void print_distribution(const gchar *label, gdouble *values, guint n) {
+    gdouble sum = 0.0;
+    for (guint i = 0; i < n; i++) sum += values[i];
+    qsort(values, n, sizeof(gdouble), compare_doubles);
+    g_print("  %-14s mean %8.1f  p10 %8.1f  p50 %8.1f  p90 %8.1f  p99 %8.1f  max %8.1f\n", label, sum / n,
+            percentile(values, n, 10), percentile(values, n, 50), percentile(values, n, 90),
+            percentile(values, n, 99), values[n - 1]);
+}
+
+static void report(const ParamSet *set, const GameResult *results, guint games) {
+    gdouble *values = g_new(gdouble, games);
+    guint stage_reached[DIFFICULTY_STAGE_COUNT + 1] = {0};
+    guint histogram[HISTOGRAM_BUCKETS] = {0};
+    guint timeouts = 0;
+
+    for (guint i = 0; i < games; i++) {
+        gdouble seconds = results[i].ticks / EVAL_TICK_RATE;
+        values[i] = seconds;
+        histogram[MIN((guint)(seconds / HISTOGRAM_BUCKET_SECONDS), HISTOGRAM_BUCKETS - 1)]++;
+        for (gint s = 1; s <= results[i].stage; s++) stage_reached[s]++;
+        if (results[i].timed_out) timeouts++;
+    }
+
+    g_print("[%s] k_speed=%g k_spawn=%g max_speed_mult=%g min_spawn_interval=%g stages=%d;%d;%d;%d\n",
+            set->name, set->params.k_speed, set->params.k_spawn, set->params.max_speed_mult,
+            set->params.min_spawn_interval, set->params.stage_max[0], set->params.stage_max[1],
+            set->params.stage_max[2], set->params.stage_max[3]);
+    print_distribution("survival (s)", values, games);
+    for (guint i = 0; i < games; i++) values[i] = results[i].score;
+    print_distribution("score", values, games);
+
+    g_print("  stage reached ");
+    for (gint s = 1; s <= DIFFICULTY_STAGE_COUNT; s++) {
+        g_print(" %d:%s %5.1f%%", s, sim_stage_name(s), 100.0 * stage_reached[s] / games);
+    }
+    g_print("\n  survival histogram (%g s buckets, %u hit the time limit):\n", HISTOGRAM_BUCKET_SECONDS, timeouts);
+    for (guint b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        gdouble share = 100.0 * histogram[b] / games;
+        gchar *bar = g_strnfill((gsize)(share / 2.0 + 0.5), '#');
+        if (b + 1 < HISTOGRAM_BUCKETS) {
+            g_print("    %3.0f-%-4.0f %5.1f%% %s\n", b * HISTOGRAM_BUCKET_SECONDS, (b + 1) * HISTOGRAM_BUCKET_SECONDS, share, bar);
+        } else {
+            g_print("    %3.0f+     %5.1f%% %s\n", b * HISTOGRAM_BUCKET_SECONDS, share, bar);
+        }
+        g_free(bar);
+    }
+    g_free(values);
+}
+
+static gdouble run_set(EvalJob *job, guint games, guint threads) {
+    gint64 start = g_get_monotonic_time();
+    work_pool_run(games, threads, play_game, job);
+    return (g_get_monotonic_time() - start) / (gdouble)G_USEC_PER_SEC;
+}
+
+// One ParamSet per group; keys that are absent keep the defaults
+static GPtrArray* load_param_sets(const gchar *path, GError **error) {
+    GKeyFile *file = g_key_file_new();
+    if (!g_key_file_load_from_file(file, path, G_KEY_FILE_NONE, error)) {
+        g_key_file_free(file);
+        return NULL;
+    }
+
+    GPtrArray *sets = g_ptr_array_new();
+    gsize n_groups = 0;
+    gchar **groups = g_key_file_get_groups(file, &n_groups);
+    for (gsize g = 0; g < n_groups; g++) {
+        ParamSet *set = g_new0(ParamSet, 1);
+        set->name = g_strdup(groups[g]);
+        difficulty_params_defaults(&set->params);
+        GError *set_error = NULL;
+        if (!difficulty_params_load(&set->params, file, groups[g], &set_error)) {
+            g_printerr("%s, skipped\n", set_error->message);
+            g_error_free(set_error);
+            g_free(set->name);
+            g_free(set);
+            continue;
+        }
+        set->table = difficulty_table_new(&set->params);
+        g_ptr_array_add(sets, set);
+    }
+    g_strfreev(groups);
+    g_key_file_free(file);
+    return sets;
+}
+
+int main(int argc, char **argv) {
+    guint games = 2000;
+    guint threads = work_pool_default_workers();
+    BotKind bot = BOT_DODGE;
+    gdouble max_seconds = 300.0;
+    guint64 first_seed = 1;
+    gboolean scaling = FALSE;
+    const gchar *params_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (g_str_has_prefix(argv[i], "--games=")) {
+            games = (guint)atoi(argv[i] + strlen("--games="));
+        } else if (g_str_has_prefix(argv[i], "--threads=")) {
+            threads = (guint)atoi(argv[i] + strlen("--threads="));
+        } else if (g_str_has_prefix(argv[i], "--bot=")) {
+            const gchar *name = argv[i] + strlen("--bot=");
+            if (g_strcmp0(name, "dodge") == 0) bot = BOT_DODGE;
+            else if (g_strcmp0(name, "random") == 0) bot = BOT_RANDOM;
+            else if (g_strcmp0(name, "idle") == 0) bot = BOT_IDLE;
+            else {
+                g_printerr("Unknown bot '%s' (dodge, random, idle)\n", name);
+                return 1;
+            }
+        } else if (g_str_has_prefix(argv[i], "--max-seconds=")) {
+            max_seconds = atof(argv[i] + strlen("--max-seconds="));
+        } else if (g_str_has_prefix(argv[i], "--seed=")) {
+            first_seed = g_ascii_strtoull(argv[i] + strlen("--seed="), NULL, 10);
+        } else if (g_strcmp0(argv[i], "--scaling") == 0) {
+            scaling = TRUE;
+        } else if (argv[i][0] != '-') {
+            params_path = argv[i];
+        } else {
+            g_printerr("Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (games == 0) games = 2000;
+    if (threads == 0) threads = work_pool_default_workers();
+    if (max_seconds <= 0.0) max_seconds = 300.0;
+
+    GPtrArray *sets;
+    if (params_path) {
+        GError *error = NULL;
+        sets = load_param_sets(params_path, &error);
+        if (!sets) {
+            g_printerr("Cannot read %s: %s\n", params_path, error->message);
+            g_error_free(error);
+            return 1;
+        }
+    } else {
+        sets = g_ptr_array_new();
+        ParamSet *set = g_new0(ParamSet, 1);
+        set->name = g_strdup("default");
+        difficulty_params_defaults(&set->params);
+        set->table = difficulty_table_new(&set->params);
+        g_ptr_array_add(sets, set);
+    }
+    if (sets->len == 0) {
+        g_printerr("No parameter sets to evaluate\n");
+        return 1;
+    }
+
+    EvalJob job;
+    job.bot = bot;
+    job.first_seed = first_seed;
+    job.max_ticks = (guint64)(max_seconds * EVAL_TICK_RATE);
+    job.sims = g_new(SimContext *, threads);
+    for (guint w = 0; w < threads; w++) job.sims[w] = sim_new();
+    job.results = g_new0(GameResult, games);
+
+    static const gchar *bot_names[] = {"dodge", "random", "idle"};
+    g_print("%u games per set, %s bot, %u threads, %.0f s limit\n\n", games, bot_names[bot], threads, max_seconds);
+
+    if (scaling) {
+        job.set = g_ptr_array_index(sets, 0);
+        gdouble base = 0.0;
+        g_print("scaling [%s]:\n", job.set->name);
+        for (guint t = 1; ; t = MIN(t * 2, threads)) {
+            gdouble seconds = run_set(&job, games, t);
+            if (t == 1) base = seconds;
+            g_print("  %2u threads  %7.3f s  %8.0f games/s  speedup %5.2fx  efficiency %5.1f%%\n",
+                    t, seconds, games / seconds, base / seconds, 100.0 * base / seconds / t);
+            if (t == threads) break;
+        }
+        g_print("\n");
+    }
+
+    for (guint s = 0; s < sets->len; s++) {
+        job.set = g_ptr_array_index(sets, s);
+        gdouble seconds = run_set(&job, games, threads);
+        report(job.set, job.results, games);
+        g_print("  %.3f s, %.0f games/s\n\n", seconds, games / seconds);
+    }
+
+    for (guint w = 0; w < threads; w++) sim_free(job.sims[w]);
+    g_free(job.sims);
+    g_free(job.results);
+    for (guint s = 0; s < sets->len; s++) {
+        ParamSet *set = g_ptr_array_index(sets, s);
+        difficulty_table_unref(set->table);
+        g_free(set->name);
+        g_free(set);
+    }
+    g_ptr_array_free(sets, TRUE);
+    return 0;
+}
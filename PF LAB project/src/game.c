@@ -7,148 +7,189 @@
 #include "player.h"
 #include "obstacle.h"
 #include "graphics.h"
+#include "background.h"
+#include "asset_pack.h"
+#include "sim.h"
+#include "profiler.h"
+#include "trace.h"
 
 static Game *game_instance = NULL;
-static Player *player = NULL;
-static ObstacleManager *obstacle_manager = NULL;
-
-static GdkPixbuf *background_image = NULL;
-static GdkPixbuf *car_sprite = NULL;
-static GdkPixbuf *obstacle_sprite = NULL;
-/* Additional obstacle variants */
-static GdkPixbuf *obs_bags1 = NULL;
-static GdkPixbuf *obs_barrel1 = NULL;
-static GdkPixbuf *obs_barrel2 = NULL;
-static GdkPixbuf *obs_barrels = NULL;
-
-// Try multiple candidate paths when loading assets so the game finds images
-// regardless of current working directory (build vs project root).
-static GdkPixbuf* find_asset(const gchar *name) {
-    const gchar *candidates[] = {"./assets/%s", "assets/%s", "../assets/%s", "%s"};
-    for (guint i = 0; i < G_N_ELEMENTS(candidates); i++) {
-        gchar *path = g_strdup_printf(candidates[i], name);
-        if (g_file_test(path, G_FILE_TEST_EXISTS)) {
-            GdkPixbuf *pb = graphics_load_image(path);
-            g_free(path);
-            return pb;
-        }
-        g_free(path);
-    }
-    // Fallback: attempt to load the raw name (may trigger fallback pixbuf inside graphics_load_image)
-    return graphics_load_image(name);
-}
+
+/* Image assets by loader slot. Sprites are attached in this order whichever
+   decode finishes first, so obstacle sprite ids (and replays) never change */
+enum {
+    ASSET_BACKGROUND,
+    ASSET_CAR,
+    ASSET_FIRST_OBSTACLE
+};
+
+static const gchar *obstacle_assets[] = {"obj_bags1.png", "obj_barrel1.png", "obj_barrel2.png", "obj_barrels.png"};
 
 /* Background scrolling state */
+static ScrollingBackground *background = NULL;
 static gdouble bg_scroll = 0.0;
-/* Speedup factor applied to major movement/score rates (20-30% increase) */
-#define SPEEDUP_FACTOR 1.25
+static gdouble bg_scroll_prev = 0.0; /* bg_scroll at the start of the current tick */
 /* Background scroll: base then scaled by SPEEDUP_FACTOR */
 static const gdouble BG_SCROLL_SPEED = 120.0 * SPEEDUP_FACTOR; /* pixels per second */
 
-/* Score rate base (points per second) scaled by SPEEDUP_FACTOR */
-#define SCORE_RATE_BASE (60.0 * SPEEDUP_FACTOR)
-
-/* Accumulator for fractional score increments */
-static gdouble score_accum = 0.0;
-
-/* ============================================================================
-   EXPONENTIAL DIFFICULTY SYSTEM
-   
-   The difficulty increases exponentially with score. This creates a smooth
-   progression from easy to extreme as the player survives longer.
-   ============================================================================ */
-
-/* Base constants for exponential scaling */
-#define BASE_SPEED 250.0           /* Base obstacle speed (px/s) before speedup */
-#define BASE_SPAWN_INTERVAL 1.5    /* Base spawn interval (seconds) */
-#define DIFFICULTY_K_SPEED 2000.0  /* Exponent divisor for speed scaling */
-#define DIFFICULTY_K_SPAWN 1500.0  /* Exponent divisor for spawn scaling */
-#define MAX_SPEED_MULT 3.0         /* Cap speed at 3x base */
-#define MIN_SPAWN_INTERVAL 0.3     /* Minimum spawn interval to prevent impossibility */
-
-/* Difficulty stages: score thresholds for stage transitions */
-#define STAGE_1_EASY_MAX 500
-#define STAGE_2_MEDIUM_MAX 1500
-#define STAGE_3_HARD_MAX 3000
-#define STAGE_4_VERYHARD_MAX 5000
-/* Stage 5 (Extreme) is everything above 5000 */
-
-/* Calculate current difficulty multipliers based on score using exponential formulas */
-static void update_difficulty(GameState *state) {
-    if (!state) return;
-    
-    gdouble score_norm = (gdouble)state->score;
-    
-    /* Exponential speed multiplier: base_speed * (1 + score/DIFFICULTY_K_SPEED)^1.5
-       This makes speed increase noticeably but controllably. */
-    gdouble speed_factor = 1.0 + (score_norm / DIFFICULTY_K_SPEED);
-    state->current_speed_multiplier = pow(speed_factor, 1.5);
-    if (state->current_speed_multiplier > MAX_SPEED_MULT) {
-        state->current_speed_multiplier = MAX_SPEED_MULT;
-    }
-    
-    /* Exponential spawn rate: base_interval / (1 + score/DIFFICULTY_K_SPAWN)^1.2
-       Smaller interval = more frequent spawns. */
-    gdouble spawn_factor = 1.0 + (score_norm / DIFFICULTY_K_SPAWN);
-    state->current_spawn_multiplier = 1.0 / pow(spawn_factor, 1.2);
-    if (state->current_spawn_multiplier < (MIN_SPAWN_INTERVAL / BASE_SPAWN_INTERVAL)) {
-        state->current_spawn_multiplier = MIN_SPAWN_INTERVAL / BASE_SPAWN_INTERVAL;
+/* HUD element: a line of text composed from the glyph cache and kept as a
+   surface; it is rebuilt only when one of the values it shows (or the render
+   scale) changes, every other frame it is a single blit */
+#define HUD_KEYS 4
+
+typedef struct {
+    gint64 keys[HUD_KEYS];
+    gdouble scale;
+    gboolean valid;
+    cairo_surface_t *surface;
+    gdouble offset_x;
+    gdouble offset_y;
+} HudText;
+
+static HudText hud_score;
+static HudText hud_debug;
+
+// TRUE (and the new values remembered) when the element has to be rebuilt for cr
+static gboolean hud_text_changed(HudText *hud, cairo_t *cr, gint64 k0, gint64 k1, gint64 k2, gint64 k3) {
+    const gint64 keys[HUD_KEYS] = {k0, k1, k2, k3};
+    gdouble scale = graphics_get_scale(cr);
+    if (hud->valid && hud->scale == scale && memcmp(hud->keys, keys, sizeof(keys)) == 0) return FALSE;
+    memcpy(hud->keys, keys, sizeof(keys));
+    hud->scale = scale;
+    hud->valid = TRUE;
+    return TRUE;
+}
+
+static void hud_text_set(HudText *hud, cairo_t *cr, const gchar *text, gdouble size, GraphicsTextStyle style) {
+    if (hud->surface) cairo_surface_destroy(hud->surface);
+    hud->surface = graphics_text_compose(cr, text, size, COLOR_WHITE, style, &hud->offset_x, &hud->offset_y);
+}
+
+static void hud_text_paint(HudText *hud, cairo_t *cr, gdouble x, gdouble y) {
+    if (!hud->surface) return;
+    x += hud->offset_x;
+    y += hud->offset_y;
+    graphics_snap_to_pixel(cr, &x, &y);
+    cairo_set_source_surface(cr, hud->surface, x, y);
+    cairo_paint(cr);
+}
+
+static void hud_text_clear(HudText *hud) {
+    if (hud->surface) cairo_surface_destroy(hud->surface);
+    hud->surface = NULL;
+    hud->valid = FALSE;
+}
+
+/* Retained layer for a static screen (menu, controls, pause, game over): its
+   boxes, paths and labels are drawn once into an offscreen surface and the
+   layer is blitted every frame until one of its keys (e.g. the final score)
+   or the render scale changes. Only the selection highlight is drawn live on top. */
+#define SCREEN_LAYER_KEYS 2
+
+typedef struct {
+    cairo_surface_t *surface;
+    gint64 keys[SCREEN_LAYER_KEYS];
+    gdouble scale;
+    gboolean valid;
+} ScreenLayer;
+
+static ScreenLayer menu_layer;
+static ScreenLayer controls_layer;
+static ScreenLayer pause_layer;
+static ScreenLayer game_over_layer;
+
+/* Returns a context to redraw the layer into when it is missing or its keys
+   changed (the caller draws and destroys it), NULL when the cached layer is current */
+static cairo_t* screen_layer_begin(ScreenLayer *layer, cairo_t *cr, cairo_content_t content, gint64 k0, gint64 k1) {
+    const gint64 keys[SCREEN_LAYER_KEYS] = {k0, k1};
+    gdouble scale = graphics_get_scale(cr);
+    if (layer->valid && layer->scale == scale && memcmp(layer->keys, keys, sizeof(keys)) == 0) return NULL;
+    memcpy(layer->keys, keys, sizeof(keys));
+    layer->valid = TRUE;
+    if (layer->surface && layer->scale != scale) {
+        cairo_surface_destroy(layer->surface);
+        layer->surface = NULL;
     }
-    
-    /* Score multiplier: increases rewards as difficulty rises
-       multiplier = 1.0 + (score / 3000.0)^0.8, capped at reasonable value */
-    gdouble mult_factor = 1.0 + pow(score_norm / 3000.0, 0.8);
-    if (mult_factor > 4.0) mult_factor = 4.0;
-    state->score_multiplier = mult_factor;
-    
-    /* Determine difficulty stage based on score thresholds */
-    if (score_norm < STAGE_1_EASY_MAX) {
-        state->difficulty_stage = 1;
-    } else if (score_norm < STAGE_2_MEDIUM_MAX) {
-        state->difficulty_stage = 2;
-    } else if (score_norm < STAGE_3_HARD_MAX) {
-        state->difficulty_stage = 3;
-    } else if (score_norm < STAGE_4_VERYHARD_MAX) {
-        state->difficulty_stage = 4;
-    } else {
-        state->difficulty_stage = 5;
+    layer->scale = scale;
+    if (!layer->surface) {
+        layer->surface = graphics_surface_create_similar_scaled(cr, content, GAME_WIDTH, GAME_HEIGHT);
     }
+    cairo_t *lcr = cairo_create(layer->surface);
+    cairo_set_operator(lcr, CAIRO_OPERATOR_CLEAR);
+    cairo_paint(lcr);
+    cairo_set_operator(lcr, CAIRO_OPERATOR_OVER);
+    return lcr;
 }
 
-/* Get a description of the current difficulty stage */
-static const gchar* get_stage_name(gint stage) {
-    switch (stage) {
-        case 1: return "EASY";
-        case 2: return "MEDIUM";
-        case 3: return "HARD";
-        case 4: return "VERY HARD";
-        case 5: return "EXTREME";
-        default: return "?";
-    }
+static void screen_layer_paint(ScreenLayer *layer, cairo_t *cr) {
+    cairo_set_source_surface(cr, layer->surface, 0, 0);
+    cairo_paint(cr);
 }
-static gint load_highscore(void) {
-    FILE *f = fopen("highscore.txt", "r");
-    if (!f) return 0;
-    gint val = 0;
-    if (fscanf(f, "%d", &val) != 1) {
-        val = 0;
-    }
-    fclose(f);
-    return val;
+
+static void screen_layer_clear(ScreenLayer *layer) {
+    if (layer->surface) cairo_surface_destroy(layer->surface);
+    layer->surface = NULL;
+    layer->valid = FALSE;
 }
 
-static void save_highscore(gint score) {
-    FILE *f = fopen("highscore.txt", "w");
-    if (!f) return; // silently ignore write failures
-    fprintf(f, "%d\n", score);
-    fclose(f);
+// Drop every HUD and screen layer surface; each is rebuilt on its next draw
+static void game_clear_render_layers(void) {
+    hud_text_clear(&hud_score);
+    hud_text_clear(&hud_debug);
+    screen_layer_clear(&menu_layer);
+    screen_layer_clear(&controls_layer);
+    screen_layer_clear(&pause_layer);
+    screen_layer_clear(&game_over_layer);
 }
 
+/* Everything one frame shows. game_render captures it from the live game and
+   draws it straight away; with a render thread it is captured into a
+   RenderFrame and drawn there, so the drawing code never reads the game. */
+typedef struct {
+    GameScreenState screen;
+    gdouble alpha;              // blend between the last two ticks
+    gdouble scroll;             // background offset, already blended
+    gint score;
+    gint highscore;
+    gint level;
+    gdouble score_multiplier;
+    gint difficulty_stage;
+    gboolean arcade_mode;
+    gint menu_selected;
+    gboolean loading;           // assets still decoding; the menu shows progress
+    gboolean start_pending;
+    guint assets_completed;
+    guint assets_count;
+    Player *player;
+    ObstacleManager *obstacles;
+} GameScene;
+
 // Forward declarations for menu drawing functions
-static void draw_main_menu(cairo_t *cr);
+static void draw_main_menu(cairo_t *cr, const GameScene *scene);
 static void draw_pause_menu(cairo_t *cr);
-static void draw_game_over_menu(cairo_t *cr, gint score);
+static void draw_game_over_menu(cairo_t *cr, gint score, gint highscore);
 static void draw_controls_screen(cairo_t *cr);
+static void draw_main_menu_layer(cairo_t *cr);
+static void draw_main_menu_selection(cairo_t *cr, gint selected);
+static void draw_pause_menu_layer(cairo_t *cr);
+static void draw_game_over_layer(cairo_t *cr, gint score, gint highscore);
+static void draw_controls_layer(cairo_t *cr);
+static void game_finish_recording(Game *game);
+static void game_request_redraw(Game *game);
+static gboolean game_update_viewport(Game *game);
+static void game_capture_scene(Game *game, GameScene *scene);
+static void game_draw_frame(const GameScene *scene, const GameViewport *viewport, cairo_t *cr);
+static void game_start_run(Game *game);
+
+/* Queue a steering key change stamped with the event's own time, for the
+   tick it happened in. Outside a live run no tick will take it, so it is
+   applied straight away (the key is still down when play resumes). */
+static void game_queue_key(Game *game, GdkEventKey *event, guint key) {
+    input_queue_push(game->input, event->time, g_get_monotonic_time(), key, event->type == GDK_KEY_PRESS);
+    if (game->state->screen_state != GAME_STATE_PLAYING || game->replay) {
+        input_queue_flush(game->input);
+    }
+}
 
 // Input handling with key tracking
 static gboolean key_press_handler(GtkWidget *widget, GdkEventKey *event, gpointer user_data) {
@@ -157,24 +198,26 @@ static gboolean key_press_handler(GtkWidget *widget, GdkEventKey *event, gpointe
     // Track key state for smooth movement
     switch (event->keyval) {
         case GDK_KEY_Left:
-            game->keys_pressed[0] = TRUE;  // Left
+            game_queue_key(game, event, SIM_INPUT_LEFT);
             return TRUE;
         case GDK_KEY_Right:
-            game->keys_pressed[1] = TRUE;  // Right
+            game_queue_key(game, event, SIM_INPUT_RIGHT);
             return TRUE;
         case GDK_KEY_Up:
             // Menu navigation when in menu
-            game->keys_pressed[2] = TRUE;  // Up
+            game_queue_key(game, event, SIM_INPUT_UP);
             if (game->state->screen_state == GAME_STATE_MENU) {
                 if (game->menu_selected > 0) game->menu_selected--;
+                game_request_redraw(game);
                 return TRUE;
             }
             return TRUE;
         case GDK_KEY_Down:
             // Menu navigation when in menu
-            game->keys_pressed[3] = TRUE;  // Down
+            game_queue_key(game, event, SIM_INPUT_DOWN);
             if (game->state->screen_state == GAME_STATE_MENU) {
                 if (game->menu_selected < 2) game->menu_selected++;
+                game_request_redraw(game);
                 return TRUE;
             }
             return TRUE;
@@ -183,12 +226,11 @@ static gboolean key_press_handler(GtkWidget *widget, GdkEventKey *event, gpointe
                         // Activate selected menu item
                         if (game->menu_selected == 0) {
                             // Start playing: reset and switch to PLAYING
-                            game_reset(game);
-                            game->state->screen_state = GAME_STATE_PLAYING;
+                            game_start_run(game);
                             if (game->drawing_area) gtk_widget_grab_focus(game->drawing_area);
                         } else if (game->menu_selected == 1) {
                             // Controls
-                            game->state->screen_state = GAME_STATE_CONTROLS;
+                            game_set_screen_state(game, GAME_STATE_CONTROLS);
                             if (game->drawing_area) gtk_widget_grab_focus(game->drawing_area);
                         } else if (game->menu_selected == 2) {
                             // Quit
@@ -196,7 +238,7 @@ static gboolean key_press_handler(GtkWidget *widget, GdkEventKey *event, gpointe
                         }
                     } else if (game->state->screen_state == GAME_STATE_CONTROLS) {
                         // Return to main menu from controls
-                        game->state->screen_state = GAME_STATE_MENU;
+                        game_set_screen_state(game, GAME_STATE_MENU);
                         if (game->drawing_area) gtk_widget_grab_focus(game->drawing_area);
                     } else if (game->state->screen_state == GAME_STATE_PLAYING) {
                 game_pause(game);
@@ -204,8 +246,7 @@ static gboolean key_press_handler(GtkWidget *widget, GdkEventKey *event, gpointe
                 game_resume(game);
             } else if (game->state->screen_state == GAME_STATE_GAME_OVER) {
                 // Restart immediately: reset game state and start playing
-                game_reset(game);
-                game->state->screen_state = GAME_STATE_PLAYING;
+                game_start_run(game);
             }
             return TRUE;
         case GDK_KEY_m:
@@ -213,34 +254,43 @@ static gboolean key_press_handler(GtkWidget *widget, GdkEventKey *event, gpointe
             /* Toggle movement mode: Arcade vs Physics (hybrid mode) */
             if (game && game->state) {
                 game->state->arcade_mode = !game->state->arcade_mode;
+                sim_set_arcade_mode(game->sim, game->state->arcade_mode);
                 g_debug("Movement mode toggled: %s", game->state->arcade_mode ? "Arcade" : "Physics");
             }
             return TRUE;
+        case GDK_KEY_q:
+        case GDK_KEY_Q:
+            /* Toggle player render quality: pre-rotated atlas vs exact rotation */
+            if (game && game->state) {
+                game->state->exact_rotation = !game->state->exact_rotation;
+                player_set_render_quality(game->sim->player, game->state->exact_rotation ? PLAYER_QUALITY_EXACT : PLAYER_QUALITY_ATLAS);
+                g_debug("Player rotation: %s", game->state->exact_rotation ? "Exact" : "Atlas");
+            }
+            return TRUE;
         case GDK_KEY_Return:
         case GDK_KEY_KP_Enter:
             // Treat Enter like Space
             if (game->state->screen_state == GAME_STATE_MENU) {
                 if (game->menu_selected == 0) {
-                    game_reset(game);
-                    game->state->screen_state = GAME_STATE_PLAYING;
+                    game_start_run(game);
                 } else if (game->menu_selected == 1) {
-                    game->state->screen_state = GAME_STATE_CONTROLS;
+                    game_set_screen_state(game, GAME_STATE_CONTROLS);
                 } else if (game->menu_selected == 2) {
                     game_stop(game);
                 }
             } else if (game->state->screen_state == GAME_STATE_CONTROLS) {
                 // Back to menu
-                game->state->screen_state = GAME_STATE_MENU;
+                game_set_screen_state(game, GAME_STATE_MENU);
             }
             return TRUE;
         case GDK_KEY_Escape:
             if (game->state->screen_state == GAME_STATE_PAUSED) {
-                game->state->screen_state = GAME_STATE_MENU;
+                game_set_screen_state(game, GAME_STATE_MENU);
             } else if (game->state->screen_state == GAME_STATE_PLAYING) {
                 game_pause(game);
                 if (game->drawing_area) gtk_widget_grab_focus(game->drawing_area);
             } else if (game->state->screen_state == GAME_STATE_CONTROLS) {
-                game->state->screen_state = GAME_STATE_MENU;
+                game_set_screen_state(game, GAME_STATE_MENU);
             } else {
                 game_stop(game);
             }
@@ -253,6 +303,25 @@ static gboolean key_press_handler(GtkWidget *widget, GdkEventKey *event, gpointe
                 game_resume(game);
             }
             return TRUE;
+        case GDK_KEY_F4:
+            /* Write the trace collected so far (--trace=FILE) */
+            if (trace_is_enabled()) {
+                GError *error = NULL;
+                if (trace_flush(&error)) {
+                    g_message("Trace written");
+                } else {
+                    g_warning("Failed to write trace: %s", error->message);
+                    g_error_free(error);
+                }
+            }
+            return TRUE;
+#ifdef PROFILER_ENABLED
+        case GDK_KEY_F3:
+            /* Frame-time profiler overlay (profiling builds only) */
+            profiler_toggle();
+            game_request_redraw(game);
+            return TRUE;
+#endif
     }
     return FALSE;
 }
@@ -262,138 +331,139 @@ static gboolean key_release_handler(GtkWidget *widget, GdkEventKey *event, gpoin
     
     switch (event->keyval) {
         case GDK_KEY_Left:
-            game->keys_pressed[0] = FALSE;
+            game_queue_key(game, event, SIM_INPUT_LEFT);
             return TRUE;
         case GDK_KEY_Right:
-            game->keys_pressed[1] = FALSE;
+            game_queue_key(game, event, SIM_INPUT_RIGHT);
             return TRUE;
         case GDK_KEY_Up:
-            game->keys_pressed[2] = FALSE;
+            game_queue_key(game, event, SIM_INPUT_UP);
             return TRUE;
         case GDK_KEY_Down:
-            game->keys_pressed[3] = FALSE;
+            game_queue_key(game, event, SIM_INPUT_DOWN);
             return TRUE;
     }
     return FALSE;
 }
 
-// Update player movement based on held keys
-static void update_player_input(Game *game, gdouble delta_time) {
-    if (!player || game->state->screen_state != GAME_STATE_PLAYING) return;
-    
-    gboolean moving_left = game->keys_pressed[0];
-    gboolean moving_right = game->keys_pressed[1];
-    gboolean moving_up = game->keys_pressed[2];
-    gboolean moving_down = game->keys_pressed[3];
-    
-    // Apply movement each frame based on held keys
-    // Left/Right: turning
-    if (game->state->arcade_mode) {
-        /* Arcade movement: direct X/Y movement independent of rotation.
-         * Use a constant speed and normalize diagonal movement so
-         * diagonal speed equals single-axis speed.
-         */
-        const gdouble ARCADE_SPEED = 400.0; /* units per second */
-        gdouble dir_x = 0.0;
-        gdouble dir_y = 0.0;
-        if (moving_left) dir_x -= 1.0;
-        if (moving_right) dir_x += 1.0;
-        if (moving_up) dir_y -= 1.0;    /* screen Y grows downward, so up is -1 */
-        if (moving_down) dir_y += 1.0;
-
-        if (dir_x == 0.0 && dir_y == 0.0) {
-            /* No movement keys: stop immediately for tight arcade feel */
-            player->velocity_x = 0.0;
-            player->velocity_y = 0.0;
-        } else {
-            /* Normalize diagonal movement so magnitude == ARCADE_SPEED */
-            gdouble len = sqrt(dir_x * dir_x + dir_y * dir_y);
-            if (len > 0.0) {
-                dir_x /= len;
-                dir_y /= len;
-            }
-            player->velocity_x = dir_x * ARCADE_SPEED;
-            player->velocity_y = dir_y * ARCADE_SPEED;
-        }
-    } else {
-        /* Physics movement (existing behavior): turning + forward/backward acceleration */
-        if (moving_left) {
-            player_move_left(player, delta_time);
-        }
-        if (moving_right) {
-            player_move_right(player, delta_time);
-        }
-
-        /* Up/Down: acceleration / braking */
-        if (moving_up) {
-            player_move_up(player, delta_time);
-        }
-        if (moving_down) {
-            player_move_down(player, delta_time);
-        }
-    }
-}
-
 // Drawing callback
 static gboolean draw_callback(GtkWidget *widget, cairo_t *cr, gpointer user_data) {
     Game *game = (Game *)user_data;
-    
-    // Draw scrolling background (if available). We draw two copies offset by GAME_HEIGHT
-    if (background_image) {
-        /* bg_scroll increases while playing; compute wrapped Y */
-        gdouble y = fmod(bg_scroll, (gdouble)GAME_HEIGHT);
-        if (y < 0) y += GAME_HEIGHT;
-
-        /* Draw the tile above and the one at y so they loop seamlessly */
-        gdouble y1 = y - GAME_HEIGHT;
-        gdouble y2 = y;
-        graphics_draw_pixbuf(cr, background_image, 0, (gint)y1, GAME_WIDTH, GAME_HEIGHT);
-        graphics_draw_pixbuf(cr, background_image, 0, (gint)y2, GAME_WIDTH, GAME_HEIGHT);
+    TRACE_BEGIN(trace, "draw_callback");
+    PROFILE_TIME_BEGIN(render_start);
+    game->frames_rendered[game->state->screen_state]++;
+    if (!game->first_frame_time) {
+        game->first_frame_time = g_get_monotonic_time();
+        g_debug("Time to first frame: %.1f ms (assets %s)", (game->first_frame_time - game->launch_time) / 1000.0,
+                game->assets_ready ? "ready" : "still loading");
+    }
+    if (game->render) {
+        /* The render thread has drawn the frame; this is one blit. A new
+           window size or scale needs a new snapshot (the old one is shown
+           until it arrives). Input counts as shown once a snapshot taken
+           after it is on screen, usually one frame behind the newest. */
+        if (game_update_viewport(game)) game_request_redraw(game);
+        guint64 shown = render_thread_paint(game->render, cr);
+        if (shown) input_queue_frame_shown(game->input, shown, g_get_monotonic_time());
     } else {
-        graphics_clear_canvas(cr, COLOR_BLACK);
+        game_update_viewport(game);
+        input_queue_frame_captured(game->input, ++game->render_serial);
+        input_queue_frame_shown(game->input, game->render_serial, g_get_monotonic_time());
+        GameScene scene;
+        game_capture_scene(game, &scene);
+        game_draw_frame(&scene, &game->viewport, cr);
+    }
+    PROFILE_TIME_END(render_start, PROFILER_PHASE_RENDER);
+    PROFILE_DRAW_OVERLAY(cr, 10, game->viewport.height - 178);
+    TRACE_END(trace);
+    return FALSE;
+}
+
+/* The scene the game shows right now, drawing the live player and obstacles */
+static void game_capture_scene(Game *game, GameScene *scene) {
+    SimContext *sim = game->sim;
+    scene->screen = game->state->screen_state;
+    /* Render state is blended between the last two simulation ticks */
+    scene->alpha = game->interp_alpha;
+    gdouble scroll_to = bg_scroll < bg_scroll_prev ? bg_scroll + GAME_HEIGHT : bg_scroll; /* wrapped this tick */
+    scene->scroll = bg_scroll_prev + (scroll_to - bg_scroll_prev) * scene->alpha;
+    scene->score = game->state->score;
+    scene->highscore = game->state->highscore;
+    scene->level = game->state->level;
+    scene->score_multiplier = sim->score_multiplier;
+    scene->difficulty_stage = sim->difficulty_stage;
+    scene->arcade_mode = game->state->arcade_mode;
+    scene->menu_selected = game->menu_selected;
+    scene->loading = game->assets != NULL;
+    scene->start_pending = game->start_pending;
+    scene->assets_completed = game->assets ? asset_loader_get_completed(game->assets) : 0;
+    scene->assets_count = game->assets ? asset_loader_get_count(game->assets) : 0;
+    scene->player = sim->player;
+    scene->obstacles = sim->obstacles;
+}
+
+// Draw one scene into cr (GAME_WIDTH x GAME_HEIGHT)
+static void game_draw_scene(const GameScene *scene, cairo_t *cr) {
+    Player *player = scene->player;
+    gdouble alpha = scene->alpha;
+
+    // Draw scrolling background (if available): one repeat-pattern blit per layer.
+    // Menu, controls and game over are opaque screen layers that cover it completely.
+    GameScreenState screen = scene->screen;
+    gboolean opaque_screen = screen == GAME_STATE_MENU || screen == GAME_STATE_CONTROLS || screen == GAME_STATE_GAME_OVER;
+    if (!opaque_screen) {
+        if (background) {
+            background_draw(background, cr, scene->scroll);
+        } else {
+            graphics_clear_canvas(cr, COLOR_BLACK);
+        }
     }
     
-    switch (game->state->screen_state) {
+    switch (screen) {
         case GAME_STATE_MENU:
-            draw_main_menu(cr);
+            draw_main_menu(cr, scene);
             break;
         case GAME_STATE_PLAYING:
-            if (player) player_draw(player, cr);
-            if (obstacle_manager) obstacle_manager_draw(obstacle_manager, cr);
+            player_draw(player, cr, alpha);
+            obstacle_manager_draw(scene->obstacles, cr, alpha);
             
-            // Draw HUD (with shadow for readability)
-            gchar score_text[120];
-            g_snprintf(score_text, sizeof(score_text), "Score: %d (x%.2f)  High: %d | Level: %d", 
-                       game->state->score, game->state->score_multiplier, game->state->highscore, game->state->level);
-            graphics_draw_text_with_shadow(cr, score_text, 14, 24, 18);
+            // Draw HUD (with shadow for readability); re-laid out only when a shown value changes
+            if (hud_text_changed(&hud_score, cr, scene->score, llround(scene->score_multiplier * 100.0),
+                                 scene->highscore, scene->level)) {
+                gchar score_text[120];
+                g_snprintf(score_text, sizeof(score_text), "Score: %d (x%.2f)  High: %d | Level: %d", 
+                           scene->score, scene->score_multiplier, scene->highscore, scene->level);
+                hud_text_set(&hud_score, cr, score_text, 18, GRAPHICS_TEXT_SHADOW);
+            }
+            hud_text_paint(&hud_score, cr, 14, 24);
             
-            /* Display difficulty stage with color coding */
+            /* Display difficulty stage (one cached string per stage) */
             gchar stage_text[64];
-            g_snprintf(stage_text, sizeof(stage_text), "Difficulty: %s", get_stage_name(game->state->difficulty_stage));
-            graphics_set_color(cr, COLOR_WHITE);
-            graphics_draw_text(cr, stage_text, GAME_WIDTH - 280, 24, 14);
+            g_snprintf(stage_text, sizeof(stage_text), "Difficulty: %s", sim_stage_name(scene->difficulty_stage));
+            graphics_draw_text_cached(cr, stage_text, GAME_WIDTH - 280, 24, 14, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_LEFT);
 
             /* Display movement mode (Arcade / Physics) */
-            gchar mode_text[64];
-            g_snprintf(mode_text, sizeof(mode_text), "Mode: %s", game->state->arcade_mode ? "Arcade" : "Physics");
-            graphics_set_color(cr, COLOR_WHITE);
-            graphics_draw_text(cr, mode_text, GAME_WIDTH - 140, 24, 14);
+            graphics_draw_text_cached(cr, scene->arcade_mode ? "Mode: Arcade" : "Mode: Physics", GAME_WIDTH - 140, 24, 14,
+                                      COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_LEFT);
 
-            // Debug overlay: show player angle and velocities
+            // Debug overlay: show player angle and velocities (keys at the printed precision)
             if (player) {
                 gdouble angle_deg = player->angle * (180.0 / M_PI);
                 gdouble vx = player->velocity_x;
                 gdouble vy = player->velocity_y;
                 gdouble fwd = vx * cos(player->angle) + vy * sin(player->angle);
-                gchar debug_text[128];
-                g_snprintf(debug_text, sizeof(debug_text), "Angle: %.2f deg  Vx: %.1f  Vy: %.1f  Fwd: %.1f", angle_deg, vx, vy, fwd);
-                graphics_set_color(cr, COLOR_WHITE);
-                graphics_draw_text(cr, debug_text, GAME_WIDTH - 420, 20, 14);
+                if (hud_text_changed(&hud_debug, cr, llround(angle_deg * 100.0), llround(vx * 10.0),
+                                     llround(vy * 10.0), llround(fwd * 10.0))) {
+                    gchar debug_text[128];
+                    g_snprintf(debug_text, sizeof(debug_text), "Angle: %.2f deg  Vx: %.1f  Vy: %.1f  Fwd: %.1f", angle_deg, vx, vy, fwd);
+                    hud_text_set(&hud_debug, cr, debug_text, 14, GRAPHICS_TEXT_PLAIN);
+                }
+                hud_text_paint(&hud_debug, cr, GAME_WIDTH - 420, 20);
             }
             break;
         case GAME_STATE_PAUSED:
-            if (player) player_draw(player, cr);
-            if (obstacle_manager) obstacle_manager_draw(obstacle_manager, cr);
+            player_draw(player, cr, alpha);
+            obstacle_manager_draw(scene->obstacles, cr, alpha);
             
             draw_pause_menu(cr);
             break;
@@ -401,35 +471,260 @@ static gboolean draw_callback(GtkWidget *widget, cairo_t *cr, gpointer user_data
             draw_controls_screen(cr);
             break;
         case GAME_STATE_GAME_OVER:
-            draw_game_over_menu(cr, game->state->score);
+            draw_game_over_menu(cr, scene->score, scene->highscore);
             break;
     }
-    
-    return FALSE;
 }
 
-// Draw main menu
-static void draw_main_menu(cairo_t *cr) {
+/* Draw the current screen into cr (GAME_WIDTH x GAME_HEIGHT). Needs no widget,
+   so benchmarks can render any screen state into an offscreen surface. */
+void game_render(Game *game, cairo_t *cr) {
+    GameScene scene;
+    game_capture_scene(game, &scene);
+    game_draw_scene(&scene, cr);
+}
+
+/* Fit the play area into a width x height window with scale_factor device
+   pixels per unit. The offsets are snapped to device pixels so the cached
+   surfaces drawn at integer game positions stay on the pixel grid. */
+static void game_viewport_fit(GameViewport *viewport, gint width, gint height, gint scale_factor) {
+    memset(viewport, 0, sizeof(*viewport));   // compared with memcmp
+    viewport->width = MAX(width, 1);
+    viewport->height = MAX(height, 1);
+    viewport->scale_factor = MAX(scale_factor, 1);
+    viewport->fit = MIN((gdouble)viewport->width / GAME_WIDTH, (gdouble)viewport->height / GAME_HEIGHT);
+    gdouble scale = viewport->scale_factor;
+    viewport->offset_x = floor((viewport->width - GAME_WIDTH * viewport->fit) / 2.0 * scale) / scale;
+    viewport->offset_y = floor((viewport->height - GAME_HEIGHT * viewport->fit) / 2.0 * scale) / scale;
+}
+
+/* Read the drawing area's size and scale factor. Returns TRUE if either
+   changed; the render thread is told to draw at the new size from now on. */
+static gboolean game_update_viewport(Game *game) {
+    if (!game->drawing_area) return FALSE;
+    GameViewport viewport;
+    game_viewport_fit(&viewport, gtk_widget_get_allocated_width(game->drawing_area),
+                      gtk_widget_get_allocated_height(game->drawing_area),
+                      gtk_widget_get_scale_factor(game->drawing_area));
+    if (memcmp(&viewport, &game->viewport, sizeof(viewport)) == 0) return FALSE;
+    game->viewport = viewport;
+    if (game->render) render_thread_resize(game->render, viewport.width, viewport.height, viewport.scale_factor);
+    return TRUE;
+}
+
+/* Draw one scene into a window: letterbox bars around the play area, then
+   the scene scaled to fit. The scene itself is drawn in game units; the
+   caches it uses follow the resulting device scale (graphics_get_scale). */
+static void game_draw_frame(const GameScene *scene, const GameViewport *viewport, cairo_t *cr) {
+    gdouble game_w = GAME_WIDTH * viewport->fit;
+    gdouble game_h = GAME_HEIGHT * viewport->fit;
+    if (game_w < viewport->width || game_h < viewport->height) {
+        cairo_save(cr);
+        cairo_rectangle(cr, 0, 0, viewport->width, viewport->height);
+        cairo_rectangle(cr, viewport->offset_x, viewport->offset_y, game_w, game_h);
+        cairo_set_fill_rule(cr, CAIRO_FILL_RULE_EVEN_ODD);
+        graphics_set_color(cr, COLOR_BLACK);
+        cairo_fill(cr);
+        cairo_restore(cr);
+    }
+    cairo_save(cr);
+    cairo_translate(cr, viewport->offset_x, viewport->offset_y);
+    cairo_scale(cr, viewport->fit, viewport->fit);
+    cairo_rectangle(cr, 0, 0, GAME_WIDTH, GAME_HEIGHT);
+    cairo_clip(cr);
+    game_draw_scene(scene, cr);
+    cairo_restore(cr);
+}
+
+/* A scene snapshot for the render thread. The player pose and the obstacle
+   pool are copied; sprites are referenced so the frame outlives a new run.
+   Frames the render thread is done with (drawn, or replaced before drawing)
+   go back to the game's spares and are captured into again, keeping their
+   pool arrays and sprite references. */
+typedef struct {
+    GameScene scene;
+    GameViewport viewport;          // window size and scale the snapshot is drawn for
+    gboolean has_player;
+    Player player;                  // pose only: no sprite, no render caches
+    GdkPixbuf *player_sprite;
+    gboolean has_obstacles;
+    ObstaclePool obstacles;
+    GPtrArray *obstacle_sprites;    // the manager's sprite templates, referenced
+    GAsyncQueue *spares;            // Game.spare_frames, where the frame returns once used
+} RenderFrame;
+
+// One pending and one being drawn are in flight; more spares than that are never needed
+#define RENDER_SPARE_FRAMES 2
+
+/* Render thread side: the copies snapshots are drawn through. They are kept
+   across frames (and runs) so their render caches are built once, and only
+   replaced when the sprites they were built from change. */
+static Player *render_player = NULL;
+static ObstacleManager *render_obstacles = NULL;
+
+// Same sprite templates, in the same order (a NULL array matches nothing)
+static gboolean sprite_templates_match(GPtrArray *a, GPtrArray *b) {
+    if (!a || !b || a->len != b->len) return FALSE;
+    for (guint i = 0; i < a->len; i++) {
+        if (g_ptr_array_index(a, i) != g_ptr_array_index(b, i)) return FALSE;
+    }
+    return TRUE;
+}
+
+static RenderFrame* render_frame_capture(Game *game) {
+    RenderFrame *frame = g_async_queue_try_pop(game->spare_frames);
+    if (!frame) {
+        frame = g_malloc0(sizeof(RenderFrame));
+        frame->spares = game->spare_frames;
+    }
+    game_capture_scene(game, &frame->scene);
+    frame->viewport = game->viewport;
+    frame->scene.player = NULL;
+    frame->scene.obstacles = NULL;
+    SimContext *sim = game->sim;
+    frame->has_player = sim->player != NULL;
+    GdkPixbuf *player_sprite = sim->player ? sim->player->sprite : NULL;
+    if (frame->player_sprite != player_sprite) {
+        if (frame->player_sprite) g_object_unref(frame->player_sprite);
+        frame->player_sprite = player_sprite ? g_object_ref(player_sprite) : NULL;
+    }
+    if (sim->player) player_copy_state(&frame->player, sim->player);
+    frame->has_obstacles = sim->obstacles != NULL;
+    if (sim->obstacles) {
+        obstacle_pool_copy(&frame->obstacles, &sim->obstacles->pool);
+        GPtrArray *templates = sim->obstacles->sprite_templates;
+        if (!sprite_templates_match(frame->obstacle_sprites, templates)) {
+            if (frame->obstacle_sprites) g_ptr_array_set_size(frame->obstacle_sprites, 0);
+            else frame->obstacle_sprites = g_ptr_array_new_with_free_func(g_object_unref);
+            for (guint i = 0; i < templates->len; i++) {
+                g_ptr_array_add(frame->obstacle_sprites, g_object_ref(g_ptr_array_index(templates, i)));
+            }
+        }
+    }
+    return frame;
+}
+
+static void render_frame_destroy(gpointer data) {
+    RenderFrame *frame = data;
+    if (frame->player_sprite) g_object_unref(frame->player_sprite);
+    obstacle_pool_clear(&frame->obstacles);
+    if (frame->obstacle_sprites) g_ptr_array_free(frame->obstacle_sprites, TRUE);
+    g_free(frame);
+}
+
+/* Called by the render thread for frames it drew and on the main thread for
+   frames a newer one replaced; either way the frame is kept for reuse */
+static void render_frame_free(gpointer data) {
+    RenderFrame *frame = data;
+    if (g_async_queue_length(frame->spares) < RENDER_SPARE_FRAMES) {
+        g_async_queue_push(frame->spares, frame);
+    } else {
+        render_frame_destroy(frame);
+    }
+}
+
+// Render thread: point the scene at the render-side copies and draw it
+static void render_frame_draw(gpointer data, cairo_t *cr, gpointer user_data) {
+    RenderFrame *frame = data;
+    GameScene scene = frame->scene;
+    if (frame->has_player) {
+        if (!render_player || render_player->sprite != frame->player_sprite) {
+            player_free(render_player);
+            render_player = player_new(0, 0, frame->player_sprite);
+        }
+        player_copy_state(render_player, &frame->player);
+        scene.player = render_player;
+    }
+    if (frame->has_obstacles) {
+        if (!render_obstacles || !sprite_templates_match(render_obstacles->sprite_templates, frame->obstacle_sprites)) {
+            if (render_obstacles) obstacle_manager_free(render_obstacles);
+            render_obstacles = obstacle_manager_new();
+            for (guint i = 0; i < frame->obstacle_sprites->len; i++) {
+                g_ptr_array_add(render_obstacles->sprite_templates, g_object_ref(g_ptr_array_index(frame->obstacle_sprites, i)));
+            }
+        }
+        obstacle_pool_copy(&render_obstacles->pool, &frame->obstacles);
+        scene.obstacles = render_obstacles;
+    }
+    game_draw_frame(&scene, &frame->viewport, cr);
+}
+
+// Snapshot the game for the render thread; input applied so far goes into this snapshot
+static void game_submit_frame(Game *game) {
+    guint64 serial = ++game->render_serial;
+    input_queue_frame_captured(game->input, serial);
+    render_thread_submit(game->render, render_frame_capture(game), serial);
+}
+
+// Main context: a newer frame is ready to blit
+static void render_frame_ready(gpointer user_data) {
+    Game *game = (Game *)user_data;
+    if (game->drawing_area) gtk_widget_queue_draw(game->drawing_area);
+}
+
+/* From here on only the render thread draws (the HUD, layer and glyph
+   caches are not locked), so it starts once the assets are attached and the
+   drawing area is realized, whichever comes last (game_assets_progress or
+   drawing_area_realize); the first snapshot is drawn before returning so the
+   window never shows a gap. Surfaces cached so far were made similar to the
+   window and are dropped, to be rebuilt on the thread against its image buffers. */
+static void game_start_render_thread(Game *game) {
+    if (game->render || !game->threaded_render || !game->assets_ready) return;
+    if (!game->drawing_area || !gtk_widget_get_realized(game->drawing_area)) return;
+    game_clear_render_layers();
+    graphics_sprite_cache_clear();
+    graphics_text_cache_clear();
+    game_update_viewport(game);
+    game->render = render_thread_new(game->viewport.width, game->viewport.height, game->viewport.scale_factor,
+                                     render_frame_draw, render_frame_free, render_frame_ready, game);
+    game_submit_frame(game);
+    render_thread_flush(game->render);
+}
+
+// Draw main menu: the static layer, then the selection highlight on top
+static void draw_main_menu(cairo_t *cr, const GameScene *scene) {
+    cairo_t *lcr = screen_layer_begin(&menu_layer, cr, CAIRO_CONTENT_COLOR, 0, 0);
+    if (lcr) {
+        draw_main_menu_layer(lcr);
+        cairo_destroy(lcr);
+    }
+    screen_layer_paint(&menu_layer, cr);
+    draw_main_menu_selection(cr, scene->menu_selected);
+
+    // Startup: images are still decoding in the background
+    if (scene->loading) {
+        gchar loading_text[64];
+        g_snprintf(loading_text, sizeof(loading_text), "%s %u/%u",
+                   scene->start_pending ? "Starting... loading assets" : "Loading assets",
+                   scene->assets_completed, scene->assets_count);
+        graphics_draw_text_cached(cr, loading_text, GAME_WIDTH/2, 470, 14, COLOR_GRAY, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    }
+}
+
+// Everything on the main menu that does not depend on the selection
+static void draw_main_menu_layer(cairo_t *cr) {
     // Dark gradient-like background
     graphics_set_color(cr, COLOR_DARK_BLUE);
     graphics_fill_rectangle(cr, 0, 0, GAME_WIDTH, GAME_HEIGHT);
     
     // Title with shadow effect
-    graphics_set_color(cr, COLOR_BLACK);
-    graphics_draw_text_centered(cr, "CAR GAME", GAME_WIDTH/2 + 2, 100 + 2, 56);
-    graphics_set_color(cr, COLOR_YELLOW);
-    graphics_draw_text_centered(cr, "CAR GAME", GAME_WIDTH/2, 100, 56);
+    graphics_draw_text_cached(cr, "CAR GAME", GAME_WIDTH/2 + 2, 100 + 2, 56, COLOR_BLACK, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "CAR GAME", GAME_WIDTH/2, 100, 56, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
     
     // Subtitle
-    graphics_set_color(cr, COLOR_LIGHT_GRAY);
-    graphics_draw_text_centered(cr, "Avoid the Red Obstacles!", GAME_WIDTH/2, 165, 18);
+    graphics_draw_text_cached(cr, "Avoid the Red Obstacles!", GAME_WIDTH/2, 165, 18, COLOR_LIGHT_GRAY, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    
+    /* Instructions removed from main menu to keep UI minimal */
     
-    // Menu options (Start, Controls, Quit) with nicer translucent rounded highlight
+    // Footer
+    graphics_draw_text_cached(cr, "Survive and avoid obstacles to score points!", GAME_WIDTH/2, 550, 12, COLOR_GRAY, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+}
+
+// Menu options (Start, Controls, Quit) with nicer translucent rounded highlight
+static void draw_main_menu_selection(cairo_t *cr, gint selected) {
     const gint start_x = GAME_WIDTH/2;
     const gint start_y = 230;
     const gint option_gap = 70;
-    gint selected = 0;
-    if (game_instance) selected = game_instance->menu_selected;
 
     // Helper to draw rounded rect background for selected item
     auto_draw_highlight:
@@ -457,29 +752,26 @@ static void draw_main_menu(cairo_t *cr) {
 
     // Draw options text
     // Start
-    if (selected == 0) graphics_set_color(cr, COLOR_BLACK);
-    else graphics_set_color(cr, COLOR_YELLOW);
-    graphics_draw_text_centered(cr, "Start Game", start_x, start_y, 28);
+    graphics_draw_text_cached(cr, "Start Game", start_x, start_y, 28, selected == 0 ? COLOR_BLACK : COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // Controls
-    if (selected == 1) graphics_set_color(cr, COLOR_BLACK);
-    else graphics_set_color(cr, COLOR_LIGHT_GRAY);
-    graphics_draw_text_centered(cr, "Controls", start_x, start_y + option_gap, 28);
+    graphics_draw_text_cached(cr, "Controls", start_x, start_y + option_gap, 28, selected == 1 ? COLOR_BLACK : COLOR_LIGHT_GRAY, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // Quit
-    if (selected == 2) graphics_set_color(cr, COLOR_BLACK);
-    else graphics_set_color(cr, COLOR_LIGHT_GRAY);
-    graphics_draw_text_centered(cr, "Quit", start_x, start_y + option_gap*2, 28);
-    
-    /* Instructions removed from main menu to keep UI minimal */
-    
-    // Footer
-    graphics_set_color(cr, COLOR_GRAY);
-    graphics_draw_text_centered(cr, "Survive and avoid obstacles to score points!", GAME_WIDTH/2, 550, 12);
+    graphics_draw_text_cached(cr, "Quit", start_x, start_y + option_gap*2, 28, selected == 2 ? COLOR_BLACK : COLOR_LIGHT_GRAY, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 }
 
-// Draw pause menu
+// Draw pause menu: a translucent layer over the frozen game scene
 static void draw_pause_menu(cairo_t *cr) {
+    cairo_t *lcr = screen_layer_begin(&pause_layer, cr, CAIRO_CONTENT_COLOR_ALPHA, 0, 0);
+    if (lcr) {
+        draw_pause_menu_layer(lcr);
+        cairo_destroy(lcr);
+    }
+    screen_layer_paint(&pause_layer, cr);
+}
+
+static void draw_pause_menu_layer(cairo_t *cr) {
     // Semi-transparent overlay
     graphics_set_color(cr, COLOR_BLACK);
     cairo_set_source_rgba(cr, 0.0, 0.0, 0.0, 0.6);
@@ -498,12 +790,10 @@ static void draw_pause_menu(cairo_t *cr) {
     graphics_draw_rectangle(cr, box_x, box_y, box_width, box_height);
     
     // Text
-    graphics_set_color(cr, COLOR_YELLOW);
-    graphics_draw_text_centered(cr, "PAUSED", GAME_WIDTH/2, box_y + 50, 40);
+    graphics_draw_text_cached(cr, "PAUSED", GAME_WIDTH/2, box_y + 50, 40, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
     
-    graphics_set_color(cr, COLOR_WHITE);
-    graphics_draw_text_centered(cr, "Press SPACE to Resume", GAME_WIDTH/2, box_y + 110, 18);
-    graphics_draw_text_centered(cr, "Press ESC for Menu", GAME_WIDTH/2, box_y + 140, 18);
+    graphics_draw_text_cached(cr, "Press SPACE to Resume", GAME_WIDTH/2, box_y + 110, 18, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "Press ESC for Menu", GAME_WIDTH/2, box_y + 140, 18, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // Draw buttons: Resume, Restart, Main Menu, Quit
     gdouble btn_w = 140;
@@ -523,15 +813,23 @@ static void draw_pause_menu(cairo_t *cr) {
     graphics_fill_rectangle(cr, menu_x, menu_y, btn_w, btn_h);
     graphics_fill_rectangle(cr, quit_x, quit_y, btn_w, btn_h);
 
-    graphics_set_color(cr, COLOR_YELLOW);
-    graphics_draw_text_centered(cr, "Resume", resume_x + btn_w/2, resume_y + 20, 14);
-    graphics_draw_text_centered(cr, "Restart", restart_x + btn_w/2, restart_y + 20, 14);
-    graphics_draw_text_centered(cr, "Main Menu", menu_x + btn_w/2, menu_y + 20, 14);
-    graphics_draw_text_centered(cr, "Quit", quit_x + btn_w/2, quit_y + 20, 14);
+    graphics_draw_text_cached(cr, "Resume", resume_x + btn_w/2, resume_y + 20, 14, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "Restart", restart_x + btn_w/2, restart_y + 20, 14, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "Main Menu", menu_x + btn_w/2, menu_y + 20, 14, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "Quit", quit_x + btn_w/2, quit_y + 20, 14, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+}
+
+// Draw game over menu; the layer is rebuilt only when the score or high score changes
+static void draw_game_over_menu(cairo_t *cr, gint score, gint highscore) {
+    cairo_t *lcr = screen_layer_begin(&game_over_layer, cr, CAIRO_CONTENT_COLOR, score, highscore);
+    if (lcr) {
+        draw_game_over_layer(lcr, score, highscore);
+        cairo_destroy(lcr);
+    }
+    screen_layer_paint(&game_over_layer, cr);
 }
 
-// Draw game over menu
-static void draw_game_over_menu(cairo_t *cr, gint score) {
+static void draw_game_over_layer(cairo_t *cr, gint score, gint highscore) {
     // Background
     graphics_set_color(cr, COLOR_DARK_BLUE);
     graphics_fill_rectangle(cr, 0, 0, GAME_WIDTH, GAME_HEIGHT);
@@ -551,36 +849,30 @@ static void draw_game_over_menu(cairo_t *cr, gint score) {
     graphics_draw_rectangle(cr, box_x, box_y, box_width, box_height);
     
     // Game Over text with shadow
-    graphics_set_color(cr, COLOR_BLACK);
-    graphics_draw_text_centered(cr, "GAME OVER", GAME_WIDTH/2 + 2, box_y + 50 + 2, 48);
-    graphics_set_color(cr, COLOR_RED);
-    graphics_draw_text_centered(cr, "GAME OVER", GAME_WIDTH/2, box_y + 50, 48);
+    graphics_draw_text_cached(cr, "GAME OVER", GAME_WIDTH/2 + 2, box_y + 50 + 2, 48, COLOR_BLACK, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "GAME OVER", GAME_WIDTH/2, box_y + 50, 48, COLOR_RED, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
     
     // Score display
-    graphics_set_color(cr, COLOR_YELLOW);
     gchar score_text[100];
     g_snprintf(score_text, sizeof(score_text), "Final Score: %d", score);
-    graphics_draw_text_centered(cr, score_text, GAME_WIDTH/2, box_y + 110, 28);
+    graphics_draw_text_cached(cr, score_text, GAME_WIDTH/2, box_y + 110, 28, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // High score display
     gchar hs_text[100];
-    g_snprintf(hs_text, sizeof(hs_text), "High Score: %d", game_instance && game_instance->state ? game_instance->state->highscore : 0);
-    graphics_draw_text_centered(cr, hs_text, GAME_WIDTH/2, box_y + 145, 20);
+    g_snprintf(hs_text, sizeof(hs_text), "High Score: %d", highscore);
+    graphics_draw_text_cached(cr, hs_text, GAME_WIDTH/2, box_y + 145, 20, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // If this run produced a new high score, show a celebration line
-    if (game_instance && game_instance->state && score == game_instance->state->highscore) {
-        graphics_set_color(cr, COLOR_YELLOW);
-        graphics_draw_text_centered(cr, "NEW HIGH SCORE!", GAME_WIDTH/2, box_y + 175, 18);
+    if (score == highscore) {
+        graphics_draw_text_cached(cr, "NEW HIGH SCORE!", GAME_WIDTH/2, box_y + 175, 18, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
     }
     
     // Instructions
-    graphics_set_color(cr, COLOR_WHITE);
-    graphics_draw_text_centered(cr, "Press SPACE to Play Again", GAME_WIDTH/2, box_y + 160, 18);
-    graphics_draw_text_centered(cr, "Press ESC to Menu", GAME_WIDTH/2, box_y + 190, 18);
+    graphics_draw_text_cached(cr, "Press SPACE to Play Again", GAME_WIDTH/2, box_y + 160, 18, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "Press ESC to Menu", GAME_WIDTH/2, box_y + 190, 18, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
     
     // Footer
-    graphics_set_color(cr, COLOR_GRAY);
-    graphics_draw_text_centered(cr, "Try to beat your score next time!", GAME_WIDTH/2, box_y + 240, 12);
+    graphics_draw_text_cached(cr, "Try to beat your score next time!", GAME_WIDTH/2, box_y + 240, 12, COLOR_GRAY, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // Draw buttons: Play Again and Main Menu
     gdouble btn_w = 140;
@@ -593,41 +885,50 @@ static void draw_game_over_menu(cairo_t *cr, gint score) {
     // Play Again button
     graphics_set_color(cr, COLOR_DARK_BLUE);
     graphics_fill_rectangle(cr, play_x, play_y, btn_w, btn_h);
-    graphics_set_color(cr, COLOR_YELLOW);
-    graphics_draw_text_centered(cr, "Play Again", play_x + btn_w/2, play_y + 22, 16);
+    graphics_draw_text_cached(cr, "Play Again", play_x + btn_w/2, play_y + 22, 16, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // Main Menu button
     graphics_set_color(cr, COLOR_DARK_BLUE);
     graphics_fill_rectangle(cr, menu_x, menu_y, btn_w, btn_h);
-    graphics_set_color(cr, COLOR_WHITE);
-    graphics_draw_text_centered(cr, "Main Menu", menu_x + btn_w/2, menu_y + 22, 16);
+    graphics_draw_text_cached(cr, "Main Menu", menu_x + btn_w/2, menu_y + 22, 16, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 }
 
 // Draw controls screen
 static void draw_controls_screen(cairo_t *cr) {
+    cairo_t *lcr = screen_layer_begin(&controls_layer, cr, CAIRO_CONTENT_COLOR, 0, 0);
+    if (lcr) {
+        draw_controls_layer(lcr);
+        cairo_destroy(lcr);
+    }
+    screen_layer_paint(&controls_layer, cr);
+}
+
+static void draw_controls_layer(cairo_t *cr) {
     graphics_set_color(cr, COLOR_DARK_BLUE);
     graphics_fill_rectangle(cr, 0, 0, GAME_WIDTH, GAME_HEIGHT);
 
-    graphics_set_color(cr, COLOR_YELLOW);
-    graphics_draw_text_centered(cr, "Controls", GAME_WIDTH/2, 80, 40);
+    graphics_draw_text_cached(cr, "Controls", GAME_WIDTH/2, 80, 40, COLOR_YELLOW, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
-    graphics_set_color(cr, COLOR_WHITE);
-    graphics_draw_text_centered(cr, "Arrow Keys - Move", GAME_WIDTH/2, 160, 20);
-    graphics_draw_text_centered(cr, "Space - Pause/Select", GAME_WIDTH/2, 200, 20);
-    graphics_draw_text_centered(cr, "Esc - Back/Quit", GAME_WIDTH/2, 240, 20);
+    graphics_draw_text_cached(cr, "Arrow Keys - Move", GAME_WIDTH/2, 160, 20, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "Space - Pause/Select", GAME_WIDTH/2, 200, 20, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+    graphics_draw_text_cached(cr, "Esc - Back/Quit", GAME_WIDTH/2, 240, 20, COLOR_WHITE, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
 
     // Back hint
-    graphics_set_color(cr, COLOR_GRAY);
-    graphics_draw_text_centered(cr, "Press SPACE or Enter to return", GAME_WIDTH/2, GAME_HEIGHT - 80, 14);
+    graphics_draw_text_cached(cr, "Press SPACE or Enter to return", GAME_WIDTH/2, GAME_HEIGHT - 80, 14, COLOR_GRAY, GRAPHICS_TEXT_PLAIN, GRAPHICS_TEXT_CENTERED);
+}
+
+// Window coordinates (pointer events) to game coordinates, through the viewport of the last frame
+static void game_window_to_game(Game *game, gdouble x, gdouble y, gdouble *game_x, gdouble *game_y) {
+    *game_x = (x - game->viewport.offset_x) / game->viewport.fit;
+    *game_y = (y - game->viewport.offset_y) / game->viewport.fit;
 }
 
 // Mouse click handler for menu interactions
 static gboolean button_press_handler(GtkWidget *widget, GdkEventButton *event, gpointer user_data) {
     Game *game = (Game *)user_data;
-    gdouble mx = event->x;
-    gdouble my = event->y;
-
     if (!game || !game->state) return FALSE;
+    gdouble mx, my;
+    game_window_to_game(game, event->x, event->y, &mx, &my);
 
     if (game->state->screen_state == GAME_STATE_MENU) {
         const gint start_x = GAME_WIDTH/2;
@@ -641,15 +942,14 @@ static gboolean button_press_handler(GtkWidget *widget, GdkEventButton *event, g
             if (mx >= cx && mx <= cx + box_w && my >= cy && my <= cy + box_h) {
                 game->menu_selected = i;
                 if (i == 0) {
-                    game_reset(game);
-                    game->state->screen_state = GAME_STATE_PLAYING;
+                    game_start_run(game);
                     if (game->drawing_area) gtk_widget_grab_focus(game->drawing_area);
                 } else if (i == 1) {
-                    game->state->screen_state = GAME_STATE_CONTROLS;
+                    game_set_screen_state(game, GAME_STATE_CONTROLS);
                 } else if (i == 2) {
                     game_stop(game);
                 }
-                if (game->drawing_area) gtk_widget_queue_draw(game->drawing_area);
+                game_request_redraw(game);
                 return TRUE;
             }
         }
@@ -665,8 +965,7 @@ static gboolean button_press_handler(GtkWidget *widget, GdkEventButton *event, g
         gdouble btn_w = 140;
         gdouble btn_h = 36;
         if (mx >= play_x && mx <= play_x + btn_w && my >= play_y && my <= play_y + btn_h) {
-            game_reset(game);
-            game->state->screen_state = GAME_STATE_PLAYING;
+            game_start_run(game);
             if (game->drawing_area) gtk_widget_grab_focus(game->drawing_area);
             return TRUE;
         }
@@ -674,7 +973,7 @@ static gboolean button_press_handler(GtkWidget *widget, GdkEventButton *event, g
         gdouble menu_x = box_x + 250;
         gdouble menu_y = play_y;
         if (mx >= menu_x && mx <= menu_x + btn_w && my >= menu_y && my <= menu_y + btn_h) {
-            game->state->screen_state = GAME_STATE_MENU;
+            game_set_screen_state(game, GAME_STATE_MENU);
             if (game->drawing_area) gtk_widget_grab_focus(game->drawing_area);
             return TRUE;
         }
@@ -697,15 +996,14 @@ static gboolean button_press_handler(GtkWidget *widget, GdkEventButton *event, g
         gdouble restart_x = box_x + 220;
         gdouble restart_y = resume_y;
         if (mx >= restart_x && mx <= restart_x + btn_w && my >= restart_y && my <= restart_y + btn_h) {
-            game_reset(game);
-            game->state->screen_state = GAME_STATE_PLAYING;
+            game_start_run(game);
             return TRUE;
         }
         // Main Menu
         gdouble menu_x = box_x + 30;
         gdouble menu_y = box_y + 110;
         if (mx >= menu_x && mx <= menu_x + btn_w && my >= menu_y && my <= menu_y + btn_h) {
-            game->state->screen_state = GAME_STATE_MENU;
+            game_set_screen_state(game, GAME_STATE_MENU);
             return TRUE;
         }
         // Quit
@@ -724,8 +1022,8 @@ static gboolean button_press_handler(GtkWidget *widget, GdkEventButton *event, g
 static gboolean motion_notify_handler(GtkWidget *widget, GdkEventMotion *event, gpointer user_data) {
     Game *game = (Game *)user_data;
     if (!game || !game->state) return FALSE;
-    gdouble mx = event->x;
-    gdouble my = event->y;
+    gdouble mx, my;
+    game_window_to_game(game, event->x, event->y, &mx, &my);
 
     if (game->state->screen_state == GAME_STATE_MENU) {
         const gint start_x = GAME_WIDTH/2;
@@ -739,7 +1037,7 @@ static gboolean motion_notify_handler(GtkWidget *widget, GdkEventMotion *event,
             if (mx >= cx && mx <= cx + box_w && my >= cy && my <= cy + box_h) {
                 if (game->menu_selected != i) {
                     game->menu_selected = i;
-                    if (game->drawing_area) gtk_widget_queue_draw(game->drawing_area);
+                    game_request_redraw(game);
                 }
                 return TRUE;
             }
@@ -749,33 +1047,148 @@ static gboolean motion_notify_handler(GtkWidget *widget, GdkEventMotion *event,
     return FALSE;
 }
 
-// Game loop timer
-static gboolean game_loop(gpointer user_data) {
-    Game *game = (Game *)user_data;
+// One fixed simulation step of dt seconds
+static void game_fixed_step(Game *game, gdouble dt) {
+    /* Background is presentation only; the simulation core snapshots its own state */
+    bg_scroll_prev = bg_scroll;
+
+    game_update(game, dt);
 
-    // Always process input so menus respond to keys
-    update_player_input(game, FRAME_TIME / 1000.0);
+    /* Advance background scroll while playing */
+    bg_scroll += BG_SCROLL_SPEED * dt;
+    if (bg_scroll >= GAME_HEIGHT) bg_scroll = fmod(bg_scroll, GAME_HEIGHT);
+}
+
+// Game loop: runs once per display frame from the GdkFrameClock
+static gboolean game_loop(GtkWidget *widget, GdkFrameClock *frame_clock, gpointer user_data) {
+    Game *game = (Game *)user_data;
+    TRACE_BEGIN(trace, "game_loop");
+
+    /* Real elapsed time since the last frame, clamped so a long hitch does not
+       queue up more catch-up work than we can ever finish */
+    gint64 now = g_get_monotonic_time();
+    if (game->last_frame_time == 0) game->last_frame_time = now;
+    gdouble frame_delta = (now - game->last_frame_time) / (gdouble)G_USEC_PER_SEC;
+    game->last_frame_time = now;
+    if (frame_delta > MAX_FRAME_DELTA) frame_delta = MAX_FRAME_DELTA;
+
+#ifdef PROFILER_ENABLED
+    gint64 refresh_interval = 0;
+    gdk_frame_clock_get_refresh_info(frame_clock, gdk_frame_clock_get_frame_time(frame_clock), &refresh_interval, NULL);
+    profiler_frame_begin(now, refresh_interval);
+#endif
 
     // Only update game logic when actively playing
     if (game->state->screen_state == GAME_STATE_PLAYING) {
-        gdouble dt = FRAME_TIME / 1000.0;
-        game_update(game, dt);
-        /* Advance background scroll while playing */
-        bg_scroll += BG_SCROLL_SPEED * dt;
-        if (bg_scroll >= GAME_HEIGHT) bg_scroll = fmod(bg_scroll, GAME_HEIGHT);
+        gdouble dt = 1.0 / game->tick_rate;
+        gint ticks = 0;
+        gint max_ticks = MAX_TICKS_PER_FRAME;
+
+        /* Replays can run faster than real time: more simulated time per frame */
+        if (game->replay) {
+            frame_delta *= game->replay_speed;
+            max_ticks = (gint)ceil(MAX_TICKS_PER_FRAME * game->replay_speed);
+        }
+
+        game->accumulator += frame_delta;
+
+        /* The ticks run now cover the real time from now - accumulator on, one
+           dt each; key events are applied to the tick whose span they fall in.
+           The last tick also takes events from the unsimulated remainder, so
+           none waits for the next frame to be seen. */
+        gint64 span_start = now - (gint64)(game->accumulator * G_USEC_PER_SEC);
+        gint due = MIN((gint)(game->accumulator / dt), max_ticks);
+        while (game->accumulator >= dt && ticks < max_ticks) {
+            ticks++;
+            game->tick_end_time = ticks == due ? now : span_start + (gint64)(ticks * dt * G_USEC_PER_SEC);
+            game_fixed_step(game, dt);
+            game->accumulator -= dt;
+            if (game->state->screen_state != GAME_STATE_PLAYING) {
+                game->accumulator = 0.0;
+                break;
+            }
+        }
+        /* Still behind after the tick budget: drop the backlog rather than spiral */
+        if (game->accumulator >= dt) game->accumulator = fmod(game->accumulator, dt);
+
+        game->interp_alpha = game->accumulator / dt;
         game->state->is_running = TRUE; // ensure loop keeps running while playing
+    } else {
+        /* Menus / pause / game over: nothing advances, show the latest state */
+        game->accumulator = 0.0;
+        game->interp_alpha = 1.0;
     }
 
-    // If we're on menu / paused / game over, do not update game logic but keep drawing
     if (game && game->drawing_area && GTK_IS_WIDGET(game->drawing_area)) {
+        game_request_redraw(game);
+    }
+
+    /* Static screen: this frame draws it, then the frame clock is released.
+       Input and state changes queue any further redraws (game_request_redraw) */
+    if (game->state->screen_state != GAME_STATE_PLAYING) {
+        game->tick_id = 0;
+        TRACE_END(trace);
+        return G_SOURCE_REMOVE;
+    }
+
+    TRACE_END(trace);
+    return G_SOURCE_CONTINUE;
+}
+
+/* Run game_loop on every display refresh; only needed while playing */
+static void game_schedule_ticks(Game *game) {
+    if (game->tick_id || !game->drawing_area) return;
+    game->last_frame_time = 0;
+    game->accumulator = 0.0;
+#ifdef PROFILER_ENABLED
+    profiler_frame_resume();
+#endif
+    game->tick_id = gtk_widget_add_tick_callback(game->drawing_area, game_loop, game, NULL);
+}
+
+/* One redraw of the current screen (menus and overlays are otherwise not
+   repainted). With a render thread the scene is snapshotted now and the
+   window repainted when the thread has drawn it (render_frame_ready). */
+static void game_request_redraw(Game *game) {
+    if (game->render) {
+        game_update_viewport(game);
+        game_submit_frame(game);
+    } else if (game->drawing_area) {
         gtk_widget_queue_draw(game->drawing_area);
     }
+}
 
-    return TRUE;
+/* Switch screens. PLAYING starts the frame clock at full rate; every other
+   screen is static, so the clock stops after its first frame and the screen
+   is only repainted on input or the next state change. */
+void game_set_screen_state(Game *game, GameScreenState state) {
+    game->state->screen_state = state;
+    if (state == GAME_STATE_PLAYING) game_schedule_ticks(game);
+    game_request_redraw(game);
+}
+
+/* Fresh run from the menu / game over. Gameplay needs its sprites, so a run
+   requested while they are still decoding starts when the last one arrives. */
+static void game_start_run(Game *game) {
+    if (!game->assets_ready) {
+        game->start_pending = TRUE;
+        game_request_redraw(game);
+        return;
+    }
+    game->start_pending = FALSE;
+    game_reset(game);
+    game_set_screen_state(game, GAME_STATE_PLAYING);
+}
+
+// The window is about to be shown; the render thread may have been waiting for it
+static void drawing_area_realize(GtkWidget *widget, gpointer user_data) {
+    game_start_render_thread((Game *)user_data);
 }
 
 // Window close handler
 static gboolean on_window_destroy(GtkWidget *widget, gpointer user_data) {
+    /* Tick callbacks die with the widget */
+    if (game_instance) game_instance->tick_id = 0;
     game_instance = NULL;
     gtk_main_quit();
     return FALSE;
@@ -790,21 +1203,115 @@ Game* game_new(void) {
     game->state->is_running = FALSE;
     game->state->is_paused = FALSE;
     game->state->screen_state = GAME_STATE_MENU;
-    /* Initialize difficulty system */
-    game->state->current_speed_multiplier = 1.0;
-    game->state->current_spawn_multiplier = 1.0;
-    game->state->score_multiplier = 1.0;
-    game->state->difficulty_stage = 1;
-    game->state->last_stage_shown = 0;
     game->state->arcade_mode = FALSE; /* default to physics movement */
-    game->timer_id = 0;
-    memset(game->keys_pressed, 0, sizeof(game->keys_pressed));
+    game->state->exact_rotation = FALSE; /* default to the pre-rotated sprite atlas */
+    game->window = NULL;
+    game->drawing_area = NULL;   /* game_init; benchmarks never create them */
+    game->tick_id = 0;
+    game->last_frame_time = 0;
+    game->accumulator = 0.0;
+    game->tick_rate = TICK_RATE;
+    game->interp_alpha = 1.0;
+    game->recorder = NULL;
+    game->record_path = NULL;
+    game->replay = NULL;
+    game->replay_speed = 1.0;
+    game->input = input_queue_new();
+    game->tick_end_time = 0;
+    game->threaded_render = FALSE;
+    game->render = NULL;
+    game->render_serial = 0;
+    game->spare_frames = g_async_queue_new_full(render_frame_destroy);
+    game_viewport_fit(&game->viewport, GAME_WIDTH, GAME_HEIGHT, 1);
     game->menu_selected = 0;
+    memset(game->frames_rendered, 0, sizeof(game->frames_rendered));
+    game->assets = NULL;
+    game->scores = NULL;
+    game->assets_ready = FALSE;
+    game->start_pending = FALSE;
+    game->launch_time = g_get_monotonic_time();
+    game->first_frame_time = 0;
+    /* Simulation core; sprites are attached in game_init once assets are loaded */
+    game->sim = sim_new();
+    sim_set_arcade_mode(game->sim, game->state->arcade_mode);
     
     game_instance = game;
     return game;
 }
 
+// Sprites, background and high score; no window needed (offscreen benchmarks call this alone)
+static AssetLoader* game_asset_loader_new(void) {
+    AssetLoader *loader = asset_loader_new();
+    // Pre-scaled images from pack_assets when present; the PNGs below otherwise
+    asset_loader_use_pack(loader, ASSET_PACK_FILE);
+    // Prefer the new background image and the rotated car; fall back to the old files
+    asset_loader_add(loader, "background-1.png", "background.png");
+    asset_loader_add(loader, "car_rotated.png", "car.png");
+    // Obstacle variants (optional)
+    for (guint i = 0; i < G_N_ELEMENTS(obstacle_assets); i++) {
+        asset_loader_add(loader, obstacle_assets[i], NULL);
+    }
+    return loader;
+}
+
+// Hand decoded images to their owners; the simulation core keeps its own references
+static void game_apply_assets(Game *game, AssetLoader *loader) {
+    sim_set_player_sprite(game->sim, asset_loader_get(loader, ASSET_CAR));
+    for (guint i = 0; i < G_N_ELEMENTS(obstacle_assets); i++) {
+        GdkPixbuf *sprite = asset_loader_get(loader, ASSET_FIRST_OBSTACLE + i);
+        if (sprite) sim_add_obstacle_sprite(game->sim, sprite);
+    }
+
+    /* Scale the background into a repeating layer; it keeps the pixbuf to rebuild at a new render scale */
+    GdkPixbuf *background_image = asset_loader_get(loader, ASSET_BACKGROUND);
+    if (background_image) {
+        background = background_new(GAME_WIDTH, GAME_HEIGHT);
+        background_add_layer(background, background_image, 1.0);
+    }
+    game->assets_ready = TRUE;
+}
+
+// Main thread, after each background decode
+static void game_assets_progress(AssetLoader *loader, guint completed, guint total, gpointer user_data) {
+    Game *game = (Game *)user_data;
+    if (completed == total) {
+        TRACE_BEGIN(trace, "game_apply_assets");
+        game_apply_assets(game, loader);
+        g_debug("Assets: %u images (%u from the pack) loaded in %.1f ms, ready %.1f ms after launch", total,
+                asset_loader_get_packed(loader), asset_loader_get_elapsed_ms(loader), (g_get_monotonic_time() - game->launch_time) / 1000.0);
+        asset_loader_free(loader);
+        game->assets = NULL;
+        TRACE_END(trace);
+        game_start_render_thread(game);
+        if (game->start_pending) game_start_run(game);
+    }
+    game_request_redraw(game);
+}
+
+// Load every asset on the calling thread (benchmarks; the window uses game_init's background load)
+void game_load_assets(Game *game) {
+    TRACE_BEGIN(trace, "game_load_assets");
+    AssetLoader *loader = game_asset_loader_new();
+    asset_loader_run_sync(loader);
+    game_apply_assets(game, loader);
+    asset_loader_free(loader);
+
+    /* Persisted high score (if any); the window path learns it in game_scores_loaded */
+    if (!game->scores) game->scores = score_store_new(SCORE_STORE_FILE, NULL, NULL);
+    score_store_wait_loaded(game->scores);
+    if (game->state) {
+        game->state->highscore = MAX(game->state->highscore, score_store_get_best(game->scores));
+    }
+    TRACE_END(trace);
+}
+
+// Main thread, once the score file has been read on the store's writer thread
+static void game_scores_loaded(ScoreStore *store, gpointer user_data) {
+    Game *game = (Game *)user_data;
+    game->state->highscore = MAX(game->state->highscore, score_store_get_best(store));
+    game_request_redraw(game);
+}
+
 void game_init(Game *game) {
     // Create main window
     game->window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
@@ -813,31 +1320,13 @@ void game_init(Game *game) {
     gtk_window_set_position(GTK_WINDOW(game->window), GTK_WIN_POS_CENTER);
     gtk_widget_set_app_paintable(game->window, TRUE);
     
-    // Load image assets using flexible loader (tries several candidate paths)
-    // Prefer the new background image name; fall back to old if missing
-    background_image = find_asset("background-1.png");
-    if (!background_image) background_image = find_asset("background.png");
-    // Prefer rotated car image if present
-    car_sprite = find_asset("car_rotated.png");
-    if (!car_sprite) car_sprite = find_asset("car.png");
-    obstacle_sprite = find_asset("obstacle.png");
-    // Load obstacle variants (optional)
-    obs_bags1 = find_asset("obj_bags1.png");
-    obs_barrel1 = find_asset("obj_barrel1.png");
-    obs_barrel2 = find_asset("obj_barrel2.png");
-    obs_barrels = find_asset("obj_barrels.png");
-
-    /* Load persisted high score (if any) */
-    if (game->state) {
-        game->state->highscore = load_highscore();
-    }
-    
     g_signal_connect(game->window, "destroy", G_CALLBACK(on_window_destroy), NULL);
     
     // Create drawing area
     game->drawing_area = gtk_drawing_area_new();
     gtk_container_add(GTK_CONTAINER(game->window), game->drawing_area);
     g_signal_connect(game->drawing_area, "draw", G_CALLBACK(draw_callback), game);
+    g_signal_connect_after(game->drawing_area, "realize", G_CALLBACK(drawing_area_realize), game);
     /* Enable mouse events for menus */
     gtk_widget_add_events(game->drawing_area, GDK_BUTTON_PRESS_MASK | GDK_POINTER_MOTION_MASK);
     g_signal_connect(game->drawing_area, "button-press-event", G_CALLBACK(button_press_handler), game);
@@ -848,179 +1337,242 @@ void game_init(Game *game) {
     gtk_widget_grab_focus(game->drawing_area);
     g_signal_connect(game->drawing_area, "key-press-event", G_CALLBACK(key_press_handler), game);
     g_signal_connect(game->drawing_area, "key-release-event", G_CALLBACK(key_release_handler), game);
-    
-    // Initialize game objects only when game starts
-    player = NULL;
-    obstacle_manager = NULL;
+
+    /* Images decode on worker threads while the window opens and the menu is
+       shown; starting a run waits for them (game_start_run). Started last:
+       with a complete pack the progress callback runs before this returns,
+       and it redraws the widget created above. */
+    game->assets = game_asset_loader_new();
+    asset_loader_start(game->assets, game_assets_progress, game);
+    game->scores = score_store_new(SCORE_STORE_FILE, game_scores_loaded, game);
 }
 
 void game_start(Game *game) {
     // Start the main loop and show the window. Game objects (player/obstacles)
     // are created when the player actually starts the game via the menu.
     game->state->is_running = TRUE;
-    game->state->screen_state = GAME_STATE_MENU;
-    if (!game->timer_id) {
-        game->timer_id = g_timeout_add(FRAME_TIME, game_loop, game);
+    game_set_screen_state(game, GAME_STATE_MENU);
+    /* A loaded replay starts playing straight away */
+    if (game->replay) {
+        game_start_run(game);
     }
     gtk_widget_show_all(game->window);
 }
 
 void game_reset(Game *game) {
-    // Reset score and level
+    /* Keep a run abandoned by a restart too */
+    game_finish_recording(game);
+
+    // Fresh run in the simulation core: player, obstacles, score and difficulty
+    guint64 seed = game->replay ? game->replay->seed : (guint64)g_get_real_time();
+    if (game->replay) replay_rewind(game->replay);
+    sim_set_seed(game->sim, seed);
+    sim_reset(game->sim);
+    if (game->record_path && !game->replay) {
+        game->recorder = replay_recorder_new(seed, game->tick_rate);
+    }
+    player_set_render_quality(game->sim->player, game->state->exact_rotation ? PLAYER_QUALITY_EXACT : PLAYER_QUALITY_ATLAS);
     game->state->score = 0;
     game->state->level = 1;
-    /* Reset difficulty system */
-    game->state->difficulty_stage = 1;
-    game->state->last_stage_shown = 0;
-    update_difficulty(game->state);
-    
-    // Reset player
-    if (player) {
-        player_free(player);
-    }
-    player = player_new(GAME_WIDTH / 2 - 25, GAME_HEIGHT - 100, car_sprite);
-    
-    // Reset obstacles
-    if (obstacle_manager) {
-        obstacle_manager_free(obstacle_manager);
-    }
-    obstacle_manager = obstacle_manager_new();
-    /* Apply initial exponential difficulty scaling to obstacles */
-    obstacle_manager->obstacle_speed = (BASE_SPEED * SPEEDUP_FACTOR) * game->state->current_speed_multiplier;
-    obstacle_manager->spawn_interval = (BASE_SPAWN_INTERVAL / SPEEDUP_FACTOR) * game->state->current_spawn_multiplier;
-    /* Add loaded obstacle variant sprites to manager (if any) */
-    if (obs_bags1) g_ptr_array_add(obstacle_manager->sprite_templates, g_object_ref(obs_bags1));
-    if (obs_barrel1) g_ptr_array_add(obstacle_manager->sprite_templates, g_object_ref(obs_barrel1));
-    if (obs_barrel2) g_ptr_array_add(obstacle_manager->sprite_templates, g_object_ref(obs_barrel2));
-    if (obs_barrels) g_ptr_array_add(obstacle_manager->sprite_templates, g_object_ref(obs_barrels));
     
     // Clear key states
-    memset(game->keys_pressed, 0, sizeof(game->keys_pressed));
+    input_queue_clear(game->input);
 }
 
 void game_stop(Game *game) {
     game->state->is_running = FALSE;
-    if (game->timer_id) {
-        g_source_remove(game->timer_id);
-        game->timer_id = 0;
+    if (game->tick_id) {
+        gtk_widget_remove_tick_callback(game->drawing_area, game->tick_id);
+        game->tick_id = 0;
     }
     gtk_main_quit();
 }
 
 void game_pause(Game *game) {
     if (game->state->screen_state == GAME_STATE_PLAYING) {
-        game->state->screen_state = GAME_STATE_PAUSED;
+        game_set_screen_state(game, GAME_STATE_PAUSED);
     }
 }
 
 void game_resume(Game *game) {
     if (game->state->screen_state == GAME_STATE_PAUSED) {
-        game->state->screen_state = GAME_STATE_PLAYING;
+        game_set_screen_state(game, GAME_STATE_PLAYING);
     }
 }
 
-// Helper function to check rectangle collision
-static gboolean check_collision(gdouble x1, gdouble y1, gdouble w1, gdouble h1,
-                                gdouble x2, gdouble y2, gdouble w2, gdouble h2) {
-    /* Shrink hitboxes slightly to make collisions feel fair and avoid early triggers.
-       We inset each box by INSET_RATIO of its size. */
-    const gdouble INSET_RATIO = 0.12; /* 12% inset */
-    gdouble ix1 = w1 * INSET_RATIO;
-    gdouble iy1 = h1 * INSET_RATIO;
-    gdouble ix2 = w2 * INSET_RATIO;
-    gdouble iy2 = h2 * INSET_RATIO;
-
-    gdouble nx1 = x1 + ix1 * 0.5;
-    gdouble ny1 = y1 + iy1 * 0.5;
-    gdouble nw1 = w1 - ix1;
-    gdouble nh1 = h1 - iy1;
-
-    gdouble nx2 = x2 + ix2 * 0.5;
-    gdouble ny2 = y2 + iy2 * 0.5;
-    gdouble nw2 = w2 - ix2;
-    gdouble nh2 = h2 - iy2;
-
-    if (nw1 <= 0 || nh1 <= 0 || nw2 <= 0 || nh2 <= 0) {
-        /* Fallback to original sizes if inset would eliminate boxes */
-        return !(x1 + w1 < x2 || x2 + w2 < x1 || y1 + h1 < y2 || y2 + h2 < y1);
+// Write the current run to record_path; the file always holds the latest run
+static void game_finish_recording(Game *game) {
+    if (!game->recorder) return;
+    GError *error = NULL;
+    guint32 flags = sim_is_over(game->sim) ? REPLAY_FLAG_GAME_OVER : 0;
+    if (!replay_recorder_save(game->recorder, game->record_path, sim_get_score(game->sim), flags, &error)) {
+        g_warning("Failed to save replay %s: %s", game->record_path, error->message);
+        g_error_free(error);
     }
+    replay_recorder_free(game->recorder);
+    game->recorder = NULL;
+}
 
-    return !(nx1 + nw1 < nx2 || nx2 + nw2 < nx1 || ny1 + nh1 < ny2 || ny2 + nh2 < ny1);
+// Record every run started after this call to path (NULL stops recording)
+void game_set_record_path(Game *game, const gchar *path) {
+    g_free(game->record_path);
+    game->record_path = g_strdup(path);
 }
 
+/* Drive runs from a recorded log instead of the keyboard, at the recorded tick
+   rate; speed > 1 plays faster than real time */
+gboolean game_load_replay(Game *game, const gchar *path, gdouble speed, GError **error) {
+    Replay *replay = replay_open(path, error);
+    if (!replay) return FALSE;
+    if (game->replay) replay_free(game->replay);
+    game->replay = replay;
+    game->replay_speed = speed > 0.0 ? speed : 1.0;
+    game_set_tick_rate(game, replay->tick_rate);
+    return TRUE;
+}
+
+/* Replace the built-in difficulty curve with one group of an ini file (NULL =
+   the first group), same format as difficulty_eval's parameter sets. Replays
+   only reproduce under the curve they were recorded with. */
+gboolean game_load_difficulty(Game *game, const gchar *path, const gchar *group, GError **error) {
+    DifficultyParams params;
+    difficulty_params_defaults(&params);
+    if (!difficulty_params_load_file(&params, path, group, error)) return FALSE;
+    sim_set_difficulty(game->sim, &params);
+    return TRUE;
+}
+
+// Advance the simulation core one tick with the held keys, then react to the outcome
 void game_update(Game *game, gdouble delta_time) {
-    if (!player || !obstacle_manager) return;
-    
-    // Update player
-    player_update(player, delta_time, GAME_WIDTH, GAME_HEIGHT);
-    
-    // Update obstacles
-    obstacle_manager_update(obstacle_manager, delta_time, GAME_HEIGHT);
-    
-    // Spawn new obstacles
-    obstacle_manager_spawn(obstacle_manager, GAME_WIDTH, GAME_HEIGHT);
-    
-    // Collision detection
-    for (guint i = 0; i < obstacle_manager->obstacles->len; i++) {
-        Obstacle *obs = g_ptr_array_index(obstacle_manager->obstacles, i);
-        
-        if (check_collision(player->x, player->y, player->width, player->height,
-                           obs->x, obs->y, obs->width, obs->height)) {
-            // Collision detected -> check high score, persist if needed, then switch to GAME_OVER
-            if (game->state) {
-                if (game->state->score > game->state->highscore) {
-                    game->state->highscore = game->state->score;
-                    save_highscore(game->state->highscore);
-                }
-            }
-            game->state->screen_state = GAME_STATE_GAME_OVER;
-            // Optionally stop further gameplay updates by returning early
+    if (!game->sim) return;
+    TRACE_BEGIN(trace, "game_update");
+    PROFILE_TIME_BEGIN(input_start);
+    PROFILE_TICK();
+
+    /* A loaded replay supplies the held keys and movement mode of every tick */
+    guint input;
+    if (game->replay) {
+        guint8 recorded;
+        if (!replay_next(game->replay, &recorded)) {
+            game_set_screen_state(game, GAME_STATE_GAME_OVER);
+            PROFILE_TIME_END(input_start, PROFILER_PHASE_INPUT);
+            TRACE_END(trace);
             return;
         }
-    }
-    
-    /* EXPONENTIAL DIFFICULTY SYSTEM: Score accumulation with multiplier */
-    score_accum += (SCORE_RATE_BASE * game->state->score_multiplier) * delta_time;
-    while (score_accum >= 1.0) {
-        game->state->score += 1;
-        score_accum -= 1.0;
-        
-        /* Update difficulty exponentially and apply to obstacles each frame */
-        update_difficulty(game->state);
-        obstacle_manager->obstacle_speed = (BASE_SPEED * SPEEDUP_FACTOR) * game->state->current_speed_multiplier;
-        obstacle_manager->spawn_interval = (BASE_SPAWN_INTERVAL / SPEEDUP_FACTOR) * game->state->current_spawn_multiplier;
+        input = recorded & ~REPLAY_INPUT_ARCADE;
+        game->state->arcade_mode = (recorded & REPLAY_INPUT_ARCADE) != 0;
+        sim_set_arcade_mode(game->sim, game->state->arcade_mode);
+    } else {
+        input = input_queue_take_tick(game->input, game->tick_end_time);
     }
 
-    /* Announce difficulty stage transitions */
-    if (game->state->difficulty_stage != game->state->last_stage_shown) {
-        g_debug("DIFFICULTY STAGE %d: %s!", game->state->difficulty_stage, get_stage_name(game->state->difficulty_stage));
-        game->state->last_stage_shown = game->state->difficulty_stage;
+    if (game->recorder) {
+        replay_recorder_push(game->recorder, input | (game->state->arcade_mode ? REPLAY_INPUT_ARCADE : 0));
     }
-    
-    // Legacy level system (kept for compatibility; exponential difficulty now primary)
-    if (game->state->score % 1000 == 0 && game->state->score > 0) {
-        game->state->level++;
+    PROFILE_TIME_END(input_start, PROFILER_PHASE_INPUT);
+
+    PROFILE_TIME_BEGIN(sim_start);
+    sim_step(game->sim, input, delta_time);
+    game->state->score = sim_get_score(game->sim);
+    game->state->level = game->sim->level;
+
+    if (sim_is_over(game->sim)) {
+        if (game->replay) {
+            g_message("Replay finished after %" G_GUINT64_FORMAT " ticks: score %d (recorded %d)",
+                      game->replay->tick, game->state->score, game->replay->final_score);
+        } else {
+            // Collision detected -> queue the run for the leaderboard (written on the store's thread)
+            if (game->scores) {
+                score_store_submit(game->scores, game->state->score,
+                                   game->state->arcade_mode ? SCORE_MODE_ARCADE : SCORE_MODE_PHYSICS);
+            }
+            game->state->highscore = MAX(game->state->highscore, game->state->score);
+        }
+        game_finish_recording(game);
+        game_set_screen_state(game, GAME_STATE_GAME_OVER);
     }
+    PROFILE_TIME_END(sim_start, PROFILER_PHASE_SIM);
+    TRACE_END(trace);
 }
 
-void game_render(Game *game, cairo_t *cr) {
-    // This is called from draw_callback
+// Rasterize on a render thread (takes effect when the assets are ready)
+void game_set_threaded_render(Game *game, gboolean enabled) {
+    if (!game) return;
+    game->threaded_render = enabled;
+}
+
+// Change the fixed simulation rate (e.g. 120 for high refresh displays)
+void game_set_tick_rate(Game *game, gdouble tick_rate) {
+    if (!game || !isfinite(tick_rate) || tick_rate <= 0.0) return;
+    game->tick_rate = tick_rate;
+    game->accumulator = 0.0;
 }
 
 void game_cleanup(Game *game) {
-    if (player) {
-        player_free(player);
-        player = NULL;
+    /* The render thread uses the caches below; stop it first */
+    if (game->render) {
+        RenderThreadStats render_stats;
+        render_thread_get_stats(game->render, &render_stats);
+        g_debug("Render thread: %" G_GUINT64_FORMAT " frames drawn (%.2f ms each), %" G_GUINT64_FORMAT " of %" G_GUINT64_FORMAT " snapshots replaced before drawing",
+                render_stats.rendered, render_stats.render_ms, render_stats.dropped, render_stats.submitted);
+        render_thread_free(game->render);
+        game->render = NULL;
+    }
+    g_async_queue_unref(game->spare_frames);   // every frame is back here now; destroys them
+    game->spare_frames = NULL;
+    player_free(render_player);
+    render_player = NULL;
+    if (render_obstacles) {
+        obstacle_manager_free(render_obstacles);
+        render_obstacles = NULL;
+    }
+
+    /* Report sprite cache behaviour: misses are resamples, steady state should be all hits */
+    SpriteCacheStats stats;
+    graphics_sprite_cache_get_stats(&stats);
+    g_debug("Sprite cache: %u hits, %u misses, %u surfaces, %u rescales", stats.hits, stats.misses, stats.entries, stats.rescales);
+    graphics_sprite_cache_clear();
+    graphics_text_cache_get_stats(&stats);
+    g_debug("Text cache: %u hits, %u misses, %u entries, %u rescales", stats.hits, stats.misses, stats.entries, stats.rescales);
+    game_clear_render_layers();
+    graphics_text_cache_clear();
+
+    /* Idle screens should show a handful of frames, not 60 per second */
+    g_debug("Frames rendered: menu %" G_GUINT64_FORMAT ", controls %" G_GUINT64_FORMAT ", playing %" G_GUINT64_FORMAT
+            ", paused %" G_GUINT64_FORMAT ", game over %" G_GUINT64_FORMAT,
+            game->frames_rendered[GAME_STATE_MENU], game->frames_rendered[GAME_STATE_CONTROLS],
+            game->frames_rendered[GAME_STATE_PLAYING], game->frames_rendered[GAME_STATE_PAUSED],
+            game->frames_rendered[GAME_STATE_GAME_OVER]);
+
+    /* Input timing: short taps are presses a per-frame key sample would have missed */
+    InputQueueStats input_stats;
+    input_queue_get_stats(game->input, &input_stats);
+    g_debug("Input: %" G_GUINT64_FORMAT " key events, %u short taps kept, %u dropped; event to frame p50 %.1f ms, p95 %.1f ms, max %.1f ms",
+            input_stats.events, input_stats.short_taps, input_stats.dropped,
+            input_stats.latency_ms[0], input_stats.latency_ms[1], input_stats.latency_ms[2]);
+    input_queue_free(game->input);
+
+    asset_loader_free(game->assets);
+    score_store_free(game->scores);    // waits for a pending score write
+    game_finish_recording(game);
+    g_free(game->record_path);
+    if (game->replay) {
+        replay_free(game->replay);
+        game->replay = NULL;
+    }
+    if (game->sim) {
+        sim_free(game->sim);
+        game->sim = NULL;
     }
-    if (obstacle_manager) {
-        obstacle_manager_free(obstacle_manager);
-        obstacle_manager = NULL;
+    if (background) {
+        background_free(background);
+        background = NULL;
     }
     if (game->state) {
         g_free(game->state);
     }
-    if (game->timer_id) {
-        g_source_remove(game->timer_id);
+    if (game->tick_id && game->drawing_area) {
+        gtk_widget_remove_tick_callback(game->drawing_area, game->tick_id);
     }
     g_free(game);
 }
@@ -1,5 +1,6 @@
 #include "graphics.h"
 #include <math.h>
+#include <string.h>
 
 // Color definitions
 const Color COLOR_BLACK = {0.0, 0.0, 0.0, 1.0};
@@ -126,19 +127,596 @@ GdkPixbuf* graphics_load_image(const gchar *filename) {
     return pixbuf;
 }
 
+/* ============================================================================
+   RENDER SCALE
+
+   Game code draws in logical units (the GAME_WIDTH x GAME_HEIGHT play area);
+   the context's transform and its target's device scale decide how many
+   device pixels one unit covers. Every cached surface is made at that density
+   (with a matching device scale, so it is still drawn in logical units) and
+   remembers the scale it was built for; a different scale rebuilds it once.
+   ============================================================================ */
+
+// Device pixels per user unit of cr (its transform times the target's device scale)
+gdouble graphics_get_scale(cairo_t *cr) {
+    cairo_matrix_t matrix;
+    cairo_get_matrix(cr, &matrix);
+    gdouble device_x, device_y;
+    cairo_surface_get_device_scale(cairo_get_target(cr), &device_x, &device_y);
+    return hypot(matrix.xx, matrix.yx) * device_x;
+}
+
+// Move (x, y) in user space onto the nearest device pixel corner, so cached surfaces blit 1:1
+void graphics_snap_to_pixel(cairo_t *cr, gdouble *x, gdouble *y) {
+    gdouble device_x, device_y;
+    cairo_surface_get_device_scale(cairo_get_target(cr), &device_x, &device_y);
+    cairo_user_to_device(cr, x, y);
+    *x = round(*x * device_x) / device_x;
+    *y = round(*y * device_y) / device_y;
+    cairo_device_to_user(cr, x, y);
+}
+
+/* Cached surfaces take exactly the requested scale as their device scale, so
+   they blit 1:1 onto a target at that scale and text drawn into them sees
+   the same graphics_get_scale as the target; their pixel extent is rounded
+   up, covering at most one device pixel more than asked for. */
+static gint scaled_size(gint size, gdouble scale) {
+    return MAX(1, (gint)ceil(size * scale - 0.001));
+}
+
+// Image surface covering width x height user units at scale device pixels per unit
+cairo_surface_t* graphics_image_surface_create_scaled(cairo_format_t format, gint width, gint height, gdouble scale) {
+    gint pixel_width = scaled_size(width, scale), pixel_height = scaled_size(height, scale);
+    cairo_surface_t *surface = cairo_image_surface_create(format, pixel_width, pixel_height);
+    cairo_surface_set_device_scale(surface, scale, scale);
+    return surface;
+}
+
+/* Surface similar to cr's target covering width x height user units of cr at
+   cr's pixel density, for caches that are later painted back into cr */
+cairo_surface_t* graphics_surface_create_similar_scaled(cairo_t *cr, cairo_content_t content, gint width, gint height) {
+    cairo_surface_t *target = cairo_get_target(cr);
+    gdouble device_x, device_y;
+    cairo_surface_get_device_scale(target, &device_x, &device_y);
+    gdouble scale = graphics_get_scale(cr);
+    /* create_similar sizes in the target's units and multiplies by its device scale */
+    gint target_width = scaled_size(width, scale / device_x), target_height = scaled_size(height, scale / device_y);
+    cairo_surface_t *surface = cairo_surface_create_similar(target, content, target_width, target_height);
+    cairo_surface_set_device_scale(surface, scale, scale);
+    return surface;
+}
+
+/* ============================================================================
+   SCALED SPRITE CACHE
+
+   Sprites are resampled and converted to cairo's premultiplied ARGB format
+   once per (source pixbuf, width, height) at the current render scale. Entries
+   are dropped automatically when the source pixbuf is finalized, and all of
+   them when the render scale changes.
+   ============================================================================ */
+
+typedef struct {
+    const GdkPixbuf *source;
+    gint width;
+    gint height;
+} SpriteCacheKey;
+
+static GHashTable *sprite_cache = NULL;     /* SpriteCacheKey* -> cairo_surface_t* */
+static GHashTable *sprite_sources = NULL;   /* set of pixbufs we hold a weak ref on */
+static SpriteCacheStats sprite_stats = {0, 0, 0, 0};
+static gdouble sprite_scale = 0.0;          /* render scale the entries were made at */
+
+static guint sprite_key_hash(gconstpointer key) {
+    const SpriteCacheKey *k = key;
+    guint h = g_direct_hash(k->source);
+    h = h * 31 + (guint)k->width;
+    h = h * 31 + (guint)k->height;
+    return h;
+}
+
+static gboolean sprite_key_equal(gconstpointer a, gconstpointer b) {
+    const SpriteCacheKey *ka = a;
+    const SpriteCacheKey *kb = b;
+    return ka->source == kb->source && ka->width == kb->width && ka->height == kb->height;
+}
+
+static gboolean sprite_entry_has_source(gpointer key, gpointer value, gpointer user_data) {
+    return ((SpriteCacheKey *)key)->source == user_data;
+}
+
+/* Weak-ref callback: the pixbuf is being finalized, drop every size cached for it */
+static void sprite_source_finalized(gpointer data, GObject *where_the_object_was) {
+    if (sprite_cache) {
+        g_hash_table_foreach_remove(sprite_cache, sprite_entry_has_source, where_the_object_was);
+    }
+    if (sprite_sources) {
+        g_hash_table_remove(sprite_sources, where_the_object_was);
+    }
+}
+
+// Convert a pixbuf to a premultiplied ARGB32 image surface (same size)
+cairo_surface_t* graphics_surface_from_pixbuf(const GdkPixbuf *pixbuf) {
+    if (!pixbuf) return NULL;
+
+    gint width = gdk_pixbuf_get_width(pixbuf);
+    gint height = gdk_pixbuf_get_height(pixbuf);
+    gint n_channels = gdk_pixbuf_get_n_channels(pixbuf);
+    gint src_stride = gdk_pixbuf_get_rowstride(pixbuf);
+    gboolean has_alpha = gdk_pixbuf_get_has_alpha(pixbuf);
+    const guchar *src = gdk_pixbuf_read_pixels(pixbuf);
+
+    cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+    if (cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS) return surface;
+    cairo_surface_flush(surface);
+    guchar *dst = cairo_image_surface_get_data(surface);
+    gint dst_stride = cairo_image_surface_get_stride(surface);
+
+    for (gint y = 0; y < height; y++) {
+        const guchar *p = src + y * src_stride;
+        guint32 *q = (guint32 *)(dst + y * dst_stride);
+        for (gint x = 0; x < width; x++) {
+            guint a = has_alpha ? p[3] : 255;
+            guint r = p[0], g = p[1], b = p[2];
+            if (a != 255) {
+                /* Same rounding as gdk_cairo_set_source_pixbuf */
+                guint t;
+                t = r * a + 0x80; r = ((t >> 8) + t) >> 8;
+                t = g * a + 0x80; g = ((t >> 8) + t) >> 8;
+                t = b * a + 0x80; b = ((t >> 8) + t) >> 8;
+            }
+            q[x] = (a << 24) | (r << 16) | (g << 8) | b;
+            p += n_channels;
+        }
+    }
+    cairo_surface_mark_dirty(surface);
+    return surface;
+}
+
+/* ============================================================================
+   PACKED IMAGES
+
+   Images from the asset pack already exist as premultiplied surfaces at their
+   in-game sizes, wrapped around the mapped file. Everything that takes a sprite
+   as a GdkPixbuf keeps working through a 1x1 stand-in pixbuf carrying those
+   surfaces: the sprite cache, the player and the background ask
+   graphics_image_surface_for_pixbuf, which hands out a matching packed surface
+   as-is and only resamples for a size the pack does not hold.
+   ============================================================================ */
+
+#define PACKED_SURFACES_KEY "graphics-packed-surfaces"
+
+GdkPixbuf* graphics_packed_pixbuf_new(void) {
+    GdkPixbuf *pixbuf = gdk_pixbuf_new(GDK_COLORSPACE_RGB, TRUE, 8, 1, 1);
+    gdk_pixbuf_fill(pixbuf, 0x00000000);
+    g_object_set_data_full(G_OBJECT(pixbuf), PACKED_SURFACES_KEY,
+                           g_ptr_array_new_with_free_func((GDestroyNotify)cairo_surface_destroy),
+                           (GDestroyNotify)g_ptr_array_unref);
+    return pixbuf;
+}
+
+// Attach one size of the image (an ARGB32 image surface; a reference is taken)
+void graphics_packed_pixbuf_add_surface(GdkPixbuf *pixbuf, cairo_surface_t *surface) {
+    GPtrArray *surfaces = g_object_get_data(G_OBJECT(pixbuf), PACKED_SURFACES_KEY);
+    if (surfaces && surface) g_ptr_array_add(surfaces, cairo_surface_reference(surface));
+}
+
+gboolean graphics_pixbuf_is_packed(GdkPixbuf *pixbuf) {
+    return pixbuf && g_object_get_data(G_OBJECT(pixbuf), PACKED_SURFACES_KEY) != NULL;
+}
+
+// Exact size if present, otherwise the largest surface (best source for resampling)
+static cairo_surface_t* packed_surface_find(GPtrArray *surfaces, gint width, gint height, gboolean *exact) {
+    cairo_surface_t *best = NULL;
+    gint best_area = 0;
+    for (guint i = 0; i < surfaces->len; i++) {
+        cairo_surface_t *s = g_ptr_array_index(surfaces, i);
+        gint w = cairo_image_surface_get_width(s), h = cairo_image_surface_get_height(s);
+        if (w == width && h == height) {
+            *exact = TRUE;
+            return s;
+        }
+        if (w * h > best_area) {
+            best = s;
+            best_area = w * h;
+        }
+    }
+    *exact = FALSE;
+    return best;
+}
+
+/* Premultiplied ARGB32 image of pixbuf at width x height (caller owns the
+   reference). Packed images at a stored size cost nothing (*shared is set:
+   the surface is the pack's own); anything else is resampled bilinearly once. */
+static cairo_surface_t* image_surface_for_pixbuf(GdkPixbuf *pixbuf, gint width, gint height, gboolean *shared) {
+    *shared = FALSE;
+    if (!pixbuf || width <= 0 || height <= 0) return NULL;
+
+    GPtrArray *surfaces = g_object_get_data(G_OBJECT(pixbuf), PACKED_SURFACES_KEY);
+    if (surfaces) {
+        gboolean exact;
+        cairo_surface_t *source = packed_surface_find(surfaces, width, height, &exact);
+        if (!source) return NULL;
+        if (exact) {
+            *shared = TRUE;
+            return cairo_surface_reference(source);
+        }
+
+        cairo_surface_t *image = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+        cairo_t *icr = cairo_create(image);
+        cairo_scale(icr, (gdouble)width / cairo_image_surface_get_width(source),
+                    (gdouble)height / cairo_image_surface_get_height(source));
+        cairo_set_source_surface(icr, source, 0, 0);
+        cairo_pattern_set_filter(cairo_get_source(icr), CAIRO_FILTER_BILINEAR);
+        cairo_set_operator(icr, CAIRO_OPERATOR_SOURCE);
+        cairo_paint(icr);
+        cairo_destroy(icr);
+        return image;
+    }
+
+    GdkPixbuf *scaled;
+    if (gdk_pixbuf_get_width(pixbuf) == width && gdk_pixbuf_get_height(pixbuf) == height) {
+        scaled = g_object_ref(pixbuf);
+    } else {
+        scaled = gdk_pixbuf_scale_simple(pixbuf, width, height, GDK_INTERP_BILINEAR);
+    }
+    if (!scaled) return NULL;
+    cairo_surface_t *image = graphics_surface_from_pixbuf(scaled);
+    g_object_unref(scaled);
+    return image;
+}
+
+cairo_surface_t* graphics_image_surface_for_pixbuf(GdkPixbuf *pixbuf, gint width, gint height) {
+    gboolean shared;
+    return image_surface_for_pixbuf(pixbuf, width, height, &shared);
+}
+
+/* As graphics_image_surface_for_pixbuf, but covering width x height user units
+   at scale device pixels per unit: resampled to the pixel size (a packed 2x
+   image serves scale 2 as-is) and given the matching device scale */
+cairo_surface_t* graphics_image_surface_for_pixbuf_scaled(GdkPixbuf *pixbuf, gint width, gint height, gdouble scale) {
+    if (scale == 1.0) return graphics_image_surface_for_pixbuf(pixbuf, width, height);
+    gint pixel_width = scaled_size(width, scale), pixel_height = scaled_size(height, scale);
+    gboolean shared;
+    cairo_surface_t *image = image_surface_for_pixbuf(pixbuf, pixel_width, pixel_height, &shared);
+    if (!image) return NULL;
+    if (shared) {
+        /* The pack's surface may be handed out at another scale too; give this
+           use its own device scale on a copy */
+        cairo_surface_t *copy = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, pixel_width, pixel_height);
+        cairo_t *ccr = cairo_create(copy);
+        cairo_set_source_surface(ccr, image, 0, 0);
+        cairo_set_operator(ccr, CAIRO_OPERATOR_SOURCE);
+        cairo_paint(ccr);
+        cairo_destroy(ccr);
+        cairo_surface_destroy(image);
+        image = copy;
+    }
+    cairo_surface_set_device_scale(image, scale, scale);
+    return image;
+}
+
+/* Resample once (to the pixel size at scale) and upload into a surface similar
+   to the destination so later paints are a plain same-format blit. Packed
+   images are used in place: the pixels stay in the mapped pack and are never copied. */
+static cairo_surface_t* create_sprite_surface(cairo_t *cr, GdkPixbuf *pixbuf, gint width, gint height, gdouble scale) {
+    cairo_surface_t *image = graphics_image_surface_for_pixbuf_scaled(pixbuf, width, height, scale);
+    if (!image) return NULL;
+    if (graphics_pixbuf_is_packed(pixbuf)) return image;
+
+    cairo_surface_t *surface = graphics_surface_create_similar_scaled(cr, CAIRO_CONTENT_COLOR_ALPHA, width, height);
+    cairo_t *scr = cairo_create(surface);
+    cairo_set_operator(scr, CAIRO_OPERATOR_SOURCE);
+    cairo_set_source_surface(scr, image, 0, 0);
+    cairo_paint(scr);
+    cairo_destroy(scr);
+    cairo_surface_destroy(image);
+    return surface;
+}
+
+// Fetch (or build) the cached surface for pixbuf at width x height user units of cr
+cairo_surface_t* graphics_sprite_cache_lookup(cairo_t *cr, GdkPixbuf *pixbuf, gint width, gint height) {
+    if (!pixbuf || width <= 0 || height <= 0) return NULL;
+
+    gdouble scale = graphics_get_scale(cr);
+    if (scale != sprite_scale) {
+        if (sprite_cache) sprite_stats.rescales++;
+        graphics_sprite_cache_clear();
+        sprite_scale = scale;
+    }
+
+    if (!sprite_cache) {
+        sprite_cache = g_hash_table_new_full(sprite_key_hash, sprite_key_equal, g_free,
+                                             (GDestroyNotify)cairo_surface_destroy);
+        sprite_sources = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+
+    SpriteCacheKey key = {pixbuf, width, height};
+    cairo_surface_t *surface = g_hash_table_lookup(sprite_cache, &key);
+    if (surface) {
+        sprite_stats.hits++;
+        return surface;
+    }
+
+    sprite_stats.misses++;
+    surface = create_sprite_surface(cr, pixbuf, width, height, scale);
+    if (!surface) return NULL;
+
+    SpriteCacheKey *stored = g_new(SpriteCacheKey, 1);
+    *stored = key;
+    g_hash_table_insert(sprite_cache, stored, surface);
+
+    if (!g_hash_table_lookup(sprite_sources, pixbuf)) {
+        g_object_weak_ref(G_OBJECT(pixbuf), sprite_source_finalized, NULL);
+        g_hash_table_insert(sprite_sources, pixbuf, pixbuf);
+    }
+    return surface;
+}
+
+void graphics_sprite_cache_get_stats(SpriteCacheStats *stats) {
+    if (!stats) return;
+    *stats = sprite_stats;
+    stats->entries = sprite_cache ? g_hash_table_size(sprite_cache) : 0;
+}
+
+void graphics_sprite_cache_reset_stats(void) {
+    sprite_stats.hits = 0;
+    sprite_stats.misses = 0;
+}
+
+static void sprite_source_unwatch(gpointer key, gpointer value, gpointer user_data) {
+    g_object_weak_unref(G_OBJECT(key), sprite_source_finalized, NULL);
+}
+
+// Drop every cached surface (e.g. on shutdown or when the target format changes)
+void graphics_sprite_cache_clear(void) {
+    if (sprite_sources) {
+        g_hash_table_foreach(sprite_sources, sprite_source_unwatch, NULL);
+        g_hash_table_destroy(sprite_sources);
+        sprite_sources = NULL;
+    }
+    if (sprite_cache) {
+        g_hash_table_destroy(sprite_cache);
+        sprite_cache = NULL;
+    }
+    sprite_scale = 0.0;
+}
+
 // Draw a pixbuf (image) to cairo context
 void graphics_draw_pixbuf(cairo_t *cr, GdkPixbuf *pixbuf, gdouble x, gdouble y, gdouble width, gdouble height) {
-    if (!pixbuf) return;
-    
-    gint pixbuf_width = gdk_pixbuf_get_width(pixbuf);
-    gint pixbuf_height = gdk_pixbuf_get_height(pixbuf);
-    
-    // Scale pixbuf to desired size
-    GdkPixbuf *scaled = gdk_pixbuf_scale_simple(pixbuf, (gint)width, (gint)height, GDK_INTERP_BILINEAR);
-    
-    // Draw to cairo
-    gdk_cairo_set_source_pixbuf(cr, scaled, x, y);
+    cairo_surface_t *sprite = graphics_sprite_cache_lookup(cr, pixbuf, (gint)width, (gint)height);
+    if (!sprite) return;
+
+    cairo_set_source_surface(cr, sprite, x, y);
     cairo_paint(cr);
-    
-    g_object_unref(scaled);
+}
+
+/* ============================================================================
+   TEXT CACHE
+
+   Font selection, layout and rasterization run once per distinct (text, size,
+   color, style); afterwards drawing the string is one surface blit. Values
+   that change every frame (scores, debug readouts) are composed from a
+   per-character glyph cache instead, so a new number never needs a relayout.
+   Both are rasterized at the render scale, with glyph origins and advances
+   on whole device pixels, and flushed when the scale changes.
+   ============================================================================ */
+
+#define TEXT_PAD 2                  /* antialiasing margin around the ink */
+#define TEXT_SHADOW_OFFSET 2
+#define TEXT_CACHE_MAX_STRINGS 512  /* whole-string entries before the cache is flushed */
+#define GLYPH_FIRST 32              /* printable ASCII range kept in a glyph set */
+#define GLYPH_LAST 126
+
+typedef struct {
+    cairo_surface_t *surface;   /* NULL for strings without ink (spaces) */
+    gint surface_width;         /* pixel size; similar surfaces are not always image surfaces */
+    gint surface_height;
+    gdouble offset_x;           /* surface origin relative to the pen position */
+    gdouble offset_y;
+    gdouble width;              /* ink width, for centering */
+    gdouble advance;            /* pen movement after the string */
+} CachedText;
+
+typedef struct {
+    CachedText glyphs[GLYPH_LAST - GLYPH_FIRST + 1];
+    gboolean built[GLYPH_LAST - GLYPH_FIRST + 1];
+} GlyphSet;
+
+static GHashTable *text_cache = NULL;    /* "size|rgba|style|text" -> CachedText* */
+static GHashTable *glyph_sets = NULL;    /* "size|rgba|style" -> GlyphSet* */
+static SpriteCacheStats text_stats = {0, 0, 0, 0};
+static gdouble text_scale = 0.0;         /* render scale the entries were made at */
+
+static void cached_text_free(gpointer data) {
+    CachedText *entry = data;
+    if (entry->surface) cairo_surface_destroy(entry->surface);
+    g_free(entry);
+}
+
+static void glyph_set_free(gpointer data) {
+    GlyphSet *set = data;
+    for (guint i = 0; i < G_N_ELEMENTS(set->glyphs); i++) {
+        if (set->glyphs[i].surface) cairo_surface_destroy(set->glyphs[i].surface);
+    }
+    g_free(set);
+}
+
+// Flush every string and glyph made at another render scale
+static void text_cache_check_scale(cairo_t *cr) {
+    gdouble scale = graphics_get_scale(cr);
+    if (scale == text_scale) return;
+    if (text_cache || glyph_sets) text_stats.rescales++;
+    graphics_text_cache_clear();
+    text_scale = scale;
+}
+
+// v rounded down / to the nearest device pixel at the text cache's scale
+static gdouble text_pixel_floor(gdouble v) {
+    return floor(v * text_scale) / text_scale;
+}
+
+static gdouble text_pixel_round(gdouble v) {
+    return round(v * text_scale) / text_scale;
+}
+
+static gchar* text_style_key(gdouble size, Color color, GraphicsTextStyle style) {
+    return g_strdup_printf("%g|%02x%02x%02x%02x|%d", size, (guint)(color.r * 255), (guint)(color.g * 255),
+                           (guint)(color.b * 255), (guint)(color.a * 255), style);
+}
+
+/* Lay out and rasterize text once into a surface similar to the target */
+static void text_rasterize(cairo_t *cr, const gchar *text, gdouble size, Color color, GraphicsTextStyle style, CachedText *out) {
+    cairo_text_extents_t extents;
+    cairo_save(cr);
+    cairo_select_font_face(cr, "sans-serif", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(cr, size);
+    cairo_text_extents(cr, text, &extents);
+    cairo_restore(cr);
+
+    gint shadow = style == GRAPHICS_TEXT_SHADOW ? TEXT_SHADOW_OFFSET : 0;
+    out->width = extents.width;
+    out->advance = extents.x_advance;
+    out->offset_x = text_pixel_floor(extents.x_bearing - TEXT_PAD);
+    out->offset_y = text_pixel_floor(extents.y_bearing - TEXT_PAD);
+    out->surface = NULL;
+    if (extents.width <= 0 || extents.height <= 0) return;
+
+    gint w = (gint)ceil(extents.width) + 2 * TEXT_PAD + 1 + shadow;
+    gint h = (gint)ceil(extents.height) + 2 * TEXT_PAD + 1 + shadow;
+    out->surface_width = w;
+    out->surface_height = h;
+    out->surface = graphics_surface_create_similar_scaled(cr, CAIRO_CONTENT_COLOR_ALPHA, w, h);
+    cairo_t *tcr = cairo_create(out->surface);
+    cairo_select_font_face(tcr, "sans-serif", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_NORMAL);
+    cairo_set_font_size(tcr, size);
+    if (shadow) {
+        cairo_set_source_rgba(tcr, 0.0, 0.0, 0.0, 0.6);
+        cairo_move_to(tcr, -out->offset_x + shadow, -out->offset_y + shadow);
+        cairo_show_text(tcr, text);
+    }
+    graphics_set_color(tcr, color);
+    cairo_move_to(tcr, -out->offset_x, -out->offset_y);
+    cairo_show_text(tcr, text);
+    cairo_destroy(tcr);
+}
+
+// Draw text through the whole-string cache; color and style replace graphics_set_color
+void graphics_draw_text_cached(cairo_t *cr, const gchar *text, gdouble x, gdouble y, gdouble size,
+                               Color color, GraphicsTextStyle style, GraphicsTextAlign align) {
+    if (!text || !*text) return;
+    text_cache_check_scale(cr);
+    if (!text_cache) {
+        text_cache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, cached_text_free);
+    }
+
+    gchar *style_key = text_style_key(size, color, style);
+    gchar *key = g_strconcat(style_key, "|", text, NULL);
+    g_free(style_key);
+    CachedText *entry = g_hash_table_lookup(text_cache, key);
+    if (entry) {
+        text_stats.hits++;
+        g_free(key);
+    } else {
+        text_stats.misses++;
+        if (g_hash_table_size(text_cache) >= TEXT_CACHE_MAX_STRINGS) {
+            g_hash_table_remove_all(text_cache);
+        }
+        entry = g_new0(CachedText, 1);
+        text_rasterize(cr, text, size, color, style, entry);
+        g_hash_table_insert(text_cache, key, entry);
+    }
+    if (!entry->surface) return;
+
+    gdouble pen_x = align == GRAPHICS_TEXT_CENTERED ? x - entry->width / 2.0 : x;
+    gdouble sx = pen_x + entry->offset_x, sy = y + entry->offset_y;
+    graphics_snap_to_pixel(cr, &sx, &sy);
+    cairo_set_source_surface(cr, entry->surface, sx, sy);
+    cairo_paint(cr);
+}
+
+static GlyphSet* glyph_set_lookup(gdouble size, Color color, GraphicsTextStyle style) {
+    if (!glyph_sets) {
+        glyph_sets = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, glyph_set_free);
+    }
+    gchar *key = text_style_key(size, color, style);
+    GlyphSet *set = g_hash_table_lookup(glyph_sets, key);
+    if (set) {
+        g_free(key);
+    } else {
+        set = g_new0(GlyphSet, 1);
+        g_hash_table_insert(glyph_sets, key, set);
+    }
+    return set;
+}
+
+/* Build a surface showing text from individually cached glyphs (no font
+   selection or layout once the glyphs exist). Kerning is ignored, which is
+   invisible for the digits and short labels this is used for. The caller owns
+   the result and paints it with its origin at (pen x + offset_x, baseline y + offset_y). */
+cairo_surface_t* graphics_text_compose(cairo_t *cr, const gchar *text, gdouble size, Color color,
+                                       GraphicsTextStyle style, gdouble *offset_x, gdouble *offset_y) {
+    text_cache_check_scale(cr);
+    GlyphSet *set = glyph_set_lookup(size, color, style);
+    gsize len = strlen(text);
+    CachedText *glyphs[256];
+    gdouble pen = 0.0, left = 0.0, right = 0.0, top = 0.0, bottom = 0.0;
+    len = MIN(len, G_N_ELEMENTS(glyphs));
+
+    for (gsize i = 0; i < len; i++) {
+        guchar c = (guchar)text[i];
+        if (c < GLYPH_FIRST || c > GLYPH_LAST) c = '?';
+        guint slot = c - GLYPH_FIRST;
+        if (!set->built[slot]) {
+            gchar s[2] = {(gchar)c, 0};
+            text_rasterize(cr, s, size, color, style, &set->glyphs[slot]);
+            set->built[slot] = TRUE;
+            text_stats.misses++;
+        } else {
+            text_stats.hits++;
+        }
+        CachedText *g = glyphs[i] = &set->glyphs[slot];
+        if (g->surface) {
+            left = MIN(left, pen + g->offset_x);
+            right = MAX(right, pen + g->offset_x + g->surface_width);
+            top = MIN(top, g->offset_y);
+            bottom = MAX(bottom, g->offset_y + g->surface_height);
+        }
+        pen += text_pixel_round(g->advance);
+    }
+
+    *offset_x = text_pixel_floor(left);
+    *offset_y = text_pixel_floor(top);
+    gint w = MAX(1, (gint)ceil(right - *offset_x));
+    gint h = MAX(1, (gint)ceil(bottom - *offset_y));
+    cairo_surface_t *surface = graphics_surface_create_similar_scaled(cr, CAIRO_CONTENT_COLOR_ALPHA, w, h);
+    cairo_t *tcr = cairo_create(surface);
+    pen = 0.0;
+    for (gsize i = 0; i < len; i++) {
+        if (glyphs[i]->surface) {
+            cairo_set_source_surface(tcr, glyphs[i]->surface, pen + glyphs[i]->offset_x - *offset_x, glyphs[i]->offset_y - *offset_y);
+            cairo_paint(tcr);
+        }
+        pen += text_pixel_round(glyphs[i]->advance);
+    }
+    cairo_destroy(tcr);
+    return surface;
+}
+
+void graphics_text_cache_get_stats(SpriteCacheStats *stats) {
+    if (!stats) return;
+    *stats = text_stats;
+    stats->entries = (text_cache ? g_hash_table_size(text_cache) : 0) + (glyph_sets ? g_hash_table_size(glyph_sets) : 0);
+}
+
+// Drop every cached string and glyph (e.g. on shutdown or when the target format changes)
+void graphics_text_cache_clear(void) {
+    if (text_cache) {
+        g_hash_table_destroy(text_cache);
+        text_cache = NULL;
+    }
+    if (glyph_sets) {
+        g_hash_table_destroy(glyph_sets);
+        glyph_sets = NULL;
+    }
+    text_scale = 0.0;
 }
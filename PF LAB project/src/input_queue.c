@@ -0,0 +1,172 @@
+#include "input_queue.h"
+#include "compare.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    gint64 time_us;
+    guint64 serial;             // first frame capturing the event, 0 = none yet
+} PendingEvent;
+
+struct InputQueue {
+    InputEvent events[INPUT_QUEUE_SIZE];
+    volatile gint head;         // next slot the producer fills, published after the write
+    volatile gint tail;         // next slot the consumer reads, published after the read
+    /* Producer side */
+    gint64 clock_offset_us;     // event clock (ms) -> monotonic clock (us)
+    gboolean clock_synced;
+    gint64 last_time_us;        // keeps the queue in time order
+    volatile gint dropped;
+    /* Consumer side */
+    guint held;                 // SimInputFlags down after the last applied event
+    guint64 applied;
+    guint short_taps;
+    PendingEvent pending[INPUT_LATENCY_PENDING];    // applied events not yet on screen
+    guint pending_count;
+    gfloat samples_ms[INPUT_LATENCY_SAMPLES];
+    guint64 sample_count;
+};
+
+InputQueue* input_queue_new(void) {
+    return g_malloc0(sizeof(InputQueue));
+}
+
+void input_queue_free(InputQueue *queue) {
+    g_free(queue);
+}
+
+/* Map an event timestamp (ms, arbitrary origin, 0 = none) onto the monotonic
+   clock. The offset is the smallest (arrival - timestamp) seen so far, i.e.
+   the event that reached us fastest; a timestamp that maps far into the past
+   means the event clock jumped or wrapped, so the offset is taken afresh. */
+static gint64 event_time(InputQueue *queue, guint32 event_time_ms, gint64 now_us) {
+    if (event_time_ms == 0) return now_us;
+    gint64 stamp_us = (gint64)event_time_ms * 1000;
+    gint64 offset = now_us - stamp_us;
+    if (!queue->clock_synced || offset < queue->clock_offset_us || offset - queue->clock_offset_us > INPUT_CLOCK_RESYNC_US) {
+        queue->clock_offset_us = offset;
+        queue->clock_synced = TRUE;
+    }
+    return stamp_us + queue->clock_offset_us;
+}
+
+/* Producer: record that key (a SimInputFlags bit) went down or up at
+   event_time_ms on the event's clock (0 = use now_us). Returns FALSE and
+   counts a drop if the consumer has fallen INPUT_QUEUE_SIZE events behind. */
+gboolean input_queue_push(InputQueue *queue, guint32 event_time_ms, gint64 now_us, guint key, gboolean pressed) {
+    gint head = queue->head;
+    if (head - g_atomic_int_get(&queue->tail) >= INPUT_QUEUE_SIZE) {
+        g_atomic_int_inc(&queue->dropped);
+        return FALSE;
+    }
+    gint64 time_us = MAX(event_time(queue, event_time_ms, now_us), queue->last_time_us);
+    queue->last_time_us = time_us;
+
+    InputEvent *event = &queue->events[head & (INPUT_QUEUE_SIZE - 1)];
+    event->time_us = time_us;
+    event->key = key;
+    event->pressed = pressed != FALSE;
+    g_atomic_int_set(&queue->head, head + 1);
+    return TRUE;
+}
+
+/* Consumer: apply every event that happened before tick_end_us and return
+   the SimInputFlags for that tick: keys held at its end, plus keys pressed
+   during it even if already released again. */
+guint input_queue_take_tick(InputQueue *queue, gint64 tick_end_us) {
+    guint tapped = 0;
+    gint tail = queue->tail;
+    gint head = g_atomic_int_get(&queue->head);
+    while (tail != head) {
+        const InputEvent *event = &queue->events[tail & (INPUT_QUEUE_SIZE - 1)];
+        if (event->time_us >= tick_end_us) break;
+        tail++;
+        // Auto-repeat presses of a key that is already down change nothing
+        if (event->pressed == ((queue->held & event->key) != 0)) continue;
+        if (event->pressed) {
+            queue->held |= event->key;
+            tapped |= event->key;
+        } else {
+            queue->held &= ~event->key;
+        }
+        queue->applied++;
+        if (queue->pending_count < INPUT_LATENCY_PENDING) {
+            PendingEvent *pending = &queue->pending[queue->pending_count++];
+            pending->time_us = event->time_us;
+            pending->serial = 0;
+        }
+    }
+    g_atomic_int_set(&queue->tail, tail);
+
+    // Taps a once-per-frame sample of the held keys would never have seen
+    for (guint lost = tapped & ~queue->held; lost; lost &= lost - 1) {
+        queue->short_taps++;
+    }
+    return queue->held | tapped;
+}
+
+// Consumer: apply everything queued with no tick to time it against (menus, replays)
+void input_queue_flush(InputQueue *queue) {
+    gint tail = queue->tail;
+    gint head = g_atomic_int_get(&queue->head);
+    for (; tail != head; tail++) {
+        const InputEvent *event = &queue->events[tail & (INPUT_QUEUE_SIZE - 1)];
+        if (event->pressed) {
+            queue->held |= event->key;
+        } else {
+            queue->held &= ~event->key;
+        }
+    }
+    g_atomic_int_set(&queue->tail, tail);
+}
+
+// Consumer: drop queued events and release every key (new run)
+void input_queue_clear(InputQueue *queue) {
+    g_atomic_int_set(&queue->tail, g_atomic_int_get(&queue->head));
+    queue->held = 0;
+    queue->pending_count = 0;
+}
+
+// Consumer: frame serial (nonzero, increasing) captured every tick simulated so far
+void input_queue_frame_captured(InputQueue *queue, guint64 serial) {
+    for (guint i = 0; i < queue->pending_count; i++) {
+        if (!queue->pending[i].serial) queue->pending[i].serial = serial;
+    }
+}
+
+/* Consumer: frame serial is on screen at frame_time_us. Events captured in
+   it or an earlier frame are shown; later ones wait for their own frame. */
+void input_queue_frame_shown(InputQueue *queue, guint64 serial, gint64 frame_time_us) {
+    guint kept = 0;
+    for (guint i = 0; i < queue->pending_count; i++) {
+        const PendingEvent *pending = &queue->pending[i];
+        if (pending->serial && pending->serial <= serial) {
+            gfloat ms = MAX(frame_time_us - pending->time_us, 0) / 1000.0f;
+            queue->samples_ms[queue->sample_count++ & (INPUT_LATENCY_SAMPLES - 1)] = ms;
+        } else {
+            queue->pending[kept++] = *pending;
+        }
+    }
+    queue->pending_count = kept;
+}
+
+void input_queue_get_stats(InputQueue *queue, InputQueueStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->events = queue->applied;
+    stats->dropped = (guint)g_atomic_int_get(&queue->dropped);
+    stats->short_taps = queue->short_taps;
+    stats->latency_count = queue->sample_count;
+
+    // Nearest-rank p50 and p95, and the maximum, of the retained samples
+    guint n = (guint)MIN(queue->sample_count, INPUT_LATENCY_SAMPLES);
+    if (n == 0) return;
+    gfloat sorted[INPUT_LATENCY_SAMPLES];
+    memcpy(sorted, queue->samples_ms, n * sizeof(gfloat));
+    qsort(sorted, n, sizeof(gfloat), compare_floats);
+    static const gdouble ranks[2] = {0.50, 0.95};
+    for (guint r = 0; r < 2; r++) {
+        guint rank = (guint)(ranks[r] * n + 0.999);
+        stats->latency_ms[r] = sorted[CLAMP(rank, 1, n) - 1];
+    }
+    stats->latency_ms[2] = sorted[n - 1];
+}
@@ -1,11 +1,61 @@
 #include <gtk/gtk.h>
+#include <stdlib.h>
 #include "game.h"
+#include "trace.h"
 
 int main(int argc, char *argv[]) {
     gtk_init(&argc, &argv);
     
     // Create and initialize game
     Game *game = game_new();
+
+    // Optional: --tick-rate=N sets the fixed simulation rate (default TICK_RATE)
+    //           --record=FILE writes each run's input log to FILE
+    //           --replay=FILE plays a recorded log (at its own tick rate), --replay-speed=N
+    //           --trace=FILE collects trace events, written on F4 and at exit
+    //           --difficulty=FILE loads a difficulty curve (ini group from --difficulty-set=NAME, default the first)
+    //           --render-thread rasterizes frames on a separate thread; the window only blits them
+    const gchar *replay_path = NULL;
+    gdouble replay_speed = 1.0;
+    const gchar *difficulty_path = NULL;
+    const gchar *difficulty_set = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (g_str_has_prefix(argv[i], "--tick-rate=")) {
+            game_set_tick_rate(game, atof(argv[i] + strlen("--tick-rate=")));
+        } else if (g_str_has_prefix(argv[i], "--record=")) {
+            game_set_record_path(game, argv[i] + strlen("--record="));
+        } else if (g_str_has_prefix(argv[i], "--replay=")) {
+            replay_path = argv[i] + strlen("--replay=");
+        } else if (g_str_has_prefix(argv[i], "--replay-speed=")) {
+            replay_speed = atof(argv[i] + strlen("--replay-speed="));
+        } else if (g_str_has_prefix(argv[i], "--trace=")) {
+            trace_enable(argv[i] + strlen("--trace="));
+        } else if (g_str_has_prefix(argv[i], "--difficulty=")) {
+            difficulty_path = argv[i] + strlen("--difficulty=");
+        } else if (g_str_has_prefix(argv[i], "--difficulty-set=")) {
+            difficulty_set = argv[i] + strlen("--difficulty-set=");
+        } else if (strcmp(argv[i], "--render-thread") == 0) {
+            game_set_threaded_render(game, TRUE);
+        }
+    }
+    if (difficulty_path) {
+        GError *error = NULL;
+        if (!game_load_difficulty(game, difficulty_path, difficulty_set, &error)) {
+            g_printerr("Cannot load difficulty: %s\n", error->message);
+            g_error_free(error);
+            game_cleanup(game);
+            return 1;
+        }
+    }
+    if (replay_path) {
+        GError *error = NULL;
+        if (!game_load_replay(game, replay_path, replay_speed, &error)) {
+            g_printerr("Cannot load replay: %s\n", error->message);
+            g_error_free(error);
+            game_cleanup(game);
+            return 1;
+        }
+    }
     game_init(game);
     game_start(game);
     
@@ -14,6 +64,15 @@ int main(int argc, char *argv[]) {
     
     // Cleanup
     game_cleanup(game);
+
+    if (trace_is_enabled()) {
+        GError *error = NULL;
+        if (!trace_flush(&error)) {
+            g_printerr("Cannot write trace: %s\n", error->message);
+            g_error_free(error);
+        }
+        trace_shutdown();
+    }
     
     return 0;
 }
@@ -1,13 +1,27 @@
 #include "obstacle.h"
 #include "graphics.h"
-#include "game.h"
+#include "sim.h"
+#include "trace.h"
 #include <stdlib.h>
-#include <time.h>
+#include <string.h>
 
+/* PCG stream ids for the two generators of a manager */
+#define OBSTACLE_RNG_STREAM_SPAWN 1
+#define OBSTACLE_RNG_STREAM_SPRITE 2
+
+const gdouble obstacle_base_size[OBSTACLE_SIZE_CLASSES][2] = {
+    {30, 30},   // small, fast
+    {40, 40},   // medium
+    {70, 50}    // large, slow
+};
+
+/* Compatibility shims: standalone heap obstacles for callers that still want
+   one. Live obstacles are stored in ObstacleManager.pool (see obstacle_manager_add_obstacle). */
 Obstacle* obstacle_new(gdouble x, gdouble y, gdouble width, gdouble height, gdouble velocity, GdkPixbuf *sprite) {
     Obstacle *obstacle = g_malloc(sizeof(Obstacle));
     obstacle->x = x;
     obstacle->y = y;
+    obstacle->prev_y = y;
     obstacle->width = width;
     obstacle->height = height;
     obstacle->velocity = velocity;
@@ -16,93 +30,384 @@ Obstacle* obstacle_new(gdouble x, gdouble y, gdouble width, gdouble height, gdou
     return obstacle;
 }
 
+static void obstacle_pool_init(ObstaclePool *pool, guint capacity) {
+    pool->x = g_new(gdouble, capacity);
+    pool->y = g_new(gdouble, capacity);
+    pool->prev_y = g_new(gdouble, capacity);
+    pool->w = g_new(gdouble, capacity);
+    pool->h = g_new(gdouble, capacity);
+    pool->vel = g_new(gdouble, capacity);
+    pool->sprite_id = g_new(gint, capacity);
+    pool->count = 0;
+    pool->capacity = capacity;
+}
+
+static void obstacle_pool_grow(ObstaclePool *pool) {
+    guint capacity = pool->capacity * 2;
+    pool->x = g_renew(gdouble, pool->x, capacity);
+    pool->y = g_renew(gdouble, pool->y, capacity);
+    pool->prev_y = g_renew(gdouble, pool->prev_y, capacity);
+    pool->w = g_renew(gdouble, pool->w, capacity);
+    pool->h = g_renew(gdouble, pool->h, capacity);
+    pool->vel = g_renew(gdouble, pool->vel, capacity);
+    pool->sprite_id = g_renew(gint, pool->sprite_id, capacity);
+    pool->capacity = capacity;
+}
+
+/* O(1) removal: move the last obstacle into slot i */
+static void obstacle_pool_swap_remove(ObstaclePool *pool, guint i) {
+    guint last = --pool->count;
+    if (i == last) return;
+    pool->x[i] = pool->x[last];
+    pool->y[i] = pool->y[last];
+    pool->prev_y[i] = pool->prev_y[last];
+    pool->w[i] = pool->w[last];
+    pool->h[i] = pool->h[last];
+    pool->vel[i] = pool->vel[last];
+    pool->sprite_id[i] = pool->sprite_id[last];
+}
+
+/* Make dst (empty or a previous copy) hold the live obstacles of src; used
+   for render snapshots, so only [0, count) is copied */
+void obstacle_pool_copy(ObstaclePool *dst, const ObstaclePool *src) {
+    if (!dst->x || dst->capacity < src->count) {
+        obstacle_pool_clear(dst);
+        obstacle_pool_init(dst, MAX(src->capacity, 1));
+    }
+    memcpy(dst->x, src->x, src->count * sizeof(gdouble));
+    memcpy(dst->y, src->y, src->count * sizeof(gdouble));
+    memcpy(dst->prev_y, src->prev_y, src->count * sizeof(gdouble));
+    memcpy(dst->w, src->w, src->count * sizeof(gdouble));
+    memcpy(dst->h, src->h, src->count * sizeof(gdouble));
+    memcpy(dst->vel, src->vel, src->count * sizeof(gdouble));
+    memcpy(dst->sprite_id, src->sprite_id, src->count * sizeof(gint));
+    dst->count = src->count;
+}
+
+void obstacle_pool_clear(ObstaclePool *pool) {
+    g_free(pool->x);
+    g_free(pool->y);
+    g_free(pool->prev_y);
+    g_free(pool->w);
+    g_free(pool->h);
+    g_free(pool->vel);
+    g_free(pool->sprite_id);
+    memset(pool, 0, sizeof(*pool));
+}
+
 ObstacleManager* obstacle_manager_new(void) {
     ObstacleManager *manager = g_malloc(sizeof(ObstacleManager));
-    manager->obstacles = g_ptr_array_new();
+    obstacle_pool_init(&manager->pool, OBSTACLE_POOL_INITIAL_CAPACITY);
+    manager->grid = spatial_grid_new(-OBSTACLE_GRID_MARGIN, -OBSTACLE_GRID_MARGIN,
+                                     GAME_WIDTH + 2 * OBSTACLE_GRID_MARGIN, GAME_HEIGHT + 2 * OBSTACLE_GRID_MARGIN,
+                                     OBSTACLE_GRID_CELL_SIZE);
+    manager->grid_dirty = TRUE;
     manager->spawn_timer = 0;
     manager->spawn_interval = 1.5;  // Spawn every 1.5 seconds
     manager->obstacle_speed = 250.0;
     manager->sprite_templates = g_ptr_array_new();
-    /* seed RNG once */
-    srand((unsigned)time(NULL));
+    memset(&manager->atlas, 0, sizeof(manager->atlas));
+    /* Unseeded managers get a fresh stream per run; call obstacle_manager_seed to reproduce one */
+    obstacle_manager_seed(manager, (guint64)g_get_real_time());
     return manager;
 }
 
-void obstacle_manager_update(ObstacleManager *manager, gdouble delta_time, gint height) {
-    for (guint i = 0; i < manager->obstacles->len; i++) {
-        Obstacle *obstacle = g_ptr_array_index(manager->obstacles, i);
-        
-        // Update position
-        obstacle->y += obstacle->velocity * delta_time;
-        
-        // Mark as inactive if off-screen
-        if (obstacle->y > height) {
-            obstacle->active = FALSE;
+// Identical seed + identical updates => identical obstacle stream
+void obstacle_manager_seed(ObstacleManager *manager, guint64 seed) {
+    rng_seed(&manager->rng.spawn, seed, OBSTACLE_RNG_STREAM_SPAWN);
+    rng_seed(&manager->rng.sprite, seed, OBSTACLE_RNG_STREAM_SPRITE);
+}
+
+void obstacle_manager_save_rng(const ObstacleManager *manager, ObstacleRngState *out) {
+    rng_snapshot(&manager->rng.spawn, &out->spawn);
+    rng_snapshot(&manager->rng.sprite, &out->sprite);
+}
+
+void obstacle_manager_restore_rng(ObstacleManager *manager, const ObstacleRngState *state) {
+    rng_restore(&manager->rng.spawn, &state->spawn);
+    rng_restore(&manager->rng.sprite, &state->sprite);
+}
+
+// Append an obstacle to the pool and return its index
+guint obstacle_manager_add(ObstacleManager *manager, gdouble x, gdouble y, gdouble width, gdouble height, gdouble velocity, gint sprite_id) {
+    ObstaclePool *pool = &manager->pool;
+    if (pool->count == pool->capacity) {
+        obstacle_pool_grow(pool);
+    }
+    guint i = pool->count++;
+    pool->x[i] = x;
+    pool->y[i] = y;
+    pool->prev_y[i] = y;
+    pool->w[i] = width;
+    pool->h[i] = height;
+    pool->vel[i] = velocity;
+    pool->sprite_id[i] = sprite_id;
+    manager->grid_dirty = TRUE;
+    return i;
+}
+
+// Compatibility: copy a standalone Obstacle into the pool (sprite must be one of the templates)
+guint obstacle_manager_add_obstacle(ObstacleManager *manager, const Obstacle *obstacle) {
+    gint sprite_id = -1;
+    for (guint t = 0; obstacle->sprite && t < manager->sprite_templates->len; t++) {
+        if (g_ptr_array_index(manager->sprite_templates, t) == obstacle->sprite) {
+            sprite_id = (gint)t;
+            break;
         }
     }
-    
-    // Remove inactive obstacles
-    for (guint i = manager->obstacles->len; i > 0; i--) {
-        Obstacle *obstacle = g_ptr_array_index(manager->obstacles, i - 1);
-        if (!obstacle->active) {
-            obstacle_free(obstacle);
-            g_ptr_array_remove_index(manager->obstacles, i - 1);
+    return obstacle_manager_add(manager, obstacle->x, obstacle->y, obstacle->width, obstacle->height,
+                                obstacle->velocity, sprite_id);
+}
+
+// Compatibility: read obstacle i as an Obstacle (sprite is borrowed, not referenced)
+void obstacle_manager_get(ObstacleManager *manager, guint index, Obstacle *out) {
+    const ObstaclePool *pool = &manager->pool;
+    out->x = pool->x[index];
+    out->y = pool->y[index];
+    out->prev_y = pool->prev_y[index];
+    out->width = pool->w[index];
+    out->height = pool->h[index];
+    out->velocity = pool->vel[index];
+    out->active = TRUE;
+    out->sprite = pool->sprite_id[index] >= 0 ? g_ptr_array_index(manager->sprite_templates, pool->sprite_id[index]) : NULL;
+}
+
+void obstacle_manager_update(ObstacleManager *manager, gdouble delta_time, gint height) {
+    ObstaclePool *pool = &manager->pool;
+    TRACE_BEGIN(trace, "obstacle_manager_update");
+
+    // Update positions
+    for (guint i = 0; i < pool->count; i++) {
+        pool->y[i] += pool->vel[i] * delta_time;
+    }
+
+    // Remove obstacles that left the screen
+    for (guint i = 0; i < pool->count; ) {
+        if (pool->y[i] > height) {
+            obstacle_pool_swap_remove(pool, i);
+        } else {
+            i++;
         }
     }
+
+    // Rebuilt by the first query after this tick, if any (most ticks use no broad phase)
+    manager->grid_dirty = TRUE;
+    TRACE_END(trace);
 }
 
-void obstacle_manager_spawn(ObstacleManager *manager, gint width, gint height) {
-    manager->spawn_timer -= 0.016;  // ~60 FPS
+/* Broad phase: obstacles whose grid cells overlap the rectangle. Candidates are
+   indices into manager->pool, valid until the next query or pool change; run
+   check_collision on them for the exact answer. */
+guint obstacle_manager_query_rect(ObstacleManager *manager, gdouble x, gdouble y, gdouble width, gdouble height, const guint **candidates) {
+    ObstaclePool *pool = &manager->pool;
+    if (manager->grid_dirty) {
+        spatial_grid_rebuild(manager->grid, pool->x, pool->y, pool->w, pool->h, pool->count);
+        manager->grid_dirty = FALSE;
+    }
+    return spatial_grid_query(manager->grid, x, y, width, height, candidates);
+}
+
+// Obstacle-vs-obstacle broad phase: neighbours of obstacle index (excluding itself)
+guint obstacle_manager_query_obstacle(ObstacleManager *manager, guint index, guint *candidates, guint max_candidates) {
+    ObstaclePool *pool = &manager->pool;
+    const guint *found = NULL;
+    guint n = obstacle_manager_query_rect(manager, pool->x[index], pool->y[index], pool->w[index], pool->h[index], &found);
+    guint written = 0;
+    for (guint k = 0; k < n && written < max_candidates; k++) {
+        if (found[k] != index) candidates[written++] = found[k];
+    }
+    return written;
+}
+
+void obstacle_manager_save_previous_state(ObstacleManager *manager) {
+    ObstaclePool *pool = &manager->pool;
+    memcpy(pool->prev_y, pool->y, pool->count * sizeof(gdouble));
+}
+
+void obstacle_manager_spawn(ObstacleManager *manager, gdouble delta_time, gint width, gint height) {
+    manager->spawn_timer -= delta_time;
 
     if (manager->spawn_timer <= 0) {
+        TRACE_BEGIN(trace, "obstacle_manager_spawn");
         /* Choose obstacle type: 0=small fast, 1=medium, 2=large slow */
-        int type = rand() % 3;
+        guint32 type = rng_range(&manager->rng.spawn, 3);
         gdouble w, h, vel;
         /* Base sizes, then scale up by ~35% to increase obstacle visibility */
         if (type == 0) {
-            w = 30; h = 30; vel = manager->obstacle_speed * 1.4;
+            vel = manager->obstacle_speed * 1.4;
         } else if (type == 1) {
-            w = 40; h = 40; vel = manager->obstacle_speed;
+            vel = manager->obstacle_speed;
         } else {
-            w = 70; h = 50; vel = manager->obstacle_speed * 0.75;
+            vel = manager->obstacle_speed * 0.75;
         }
-        const gdouble SIZE_SCALE = 1.35; /* 35% larger */
-        w *= SIZE_SCALE;
-        h *= SIZE_SCALE;
+        w = obstacle_base_size[type][0] * OBSTACLE_SIZE_SCALE;
+        h = obstacle_base_size[type][1] * OBSTACLE_SIZE_SCALE;
 
         /* Random x position constrained by obstacle width */
         gint max_x = (width - (gint)w);
         if (max_x < 0) max_x = 0;
-        gdouble x = (max_x > 0) ? (rand() % max_x) : 0;
+        gdouble x = (max_x > 0) ? rng_range(&manager->rng.spawn, (guint32)max_x) : 0;
 
         /* Pick a random sprite template if available */
-        GdkPixbuf *chosen = NULL;
+        gint sprite_id = -1;
         if (manager->sprite_templates && manager->sprite_templates->len > 0) {
-            guint idx = rand() % manager->sprite_templates->len;
-            chosen = g_ptr_array_index(manager->sprite_templates, idx);
+            sprite_id = (gint)rng_range(&manager->rng.sprite, manager->sprite_templates->len);
         }
 
-        Obstacle *obstacle = obstacle_new(x, -h - 10, w, h, vel, chosen);
-        g_ptr_array_add(manager->obstacles, obstacle);
+        obstacle_manager_add(manager, x, -h - 10, w, h, vel, sprite_id);
 
         manager->spawn_timer = manager->spawn_interval;
+        TRACE_END(trace);
     }
 }
 
-void obstacle_manager_draw(ObstacleManager *manager, cairo_t *cr) {
-    graphics_set_color(cr, COLOR_RED);
-    
-    for (guint i = 0; i < manager->obstacles->len; i++) {
-        Obstacle *obstacle = g_ptr_array_index(manager->obstacles, i);
-        if (obstacle->sprite) {
-            graphics_draw_pixbuf(cr, obstacle->sprite, obstacle->x, obstacle->y, obstacle->width, obstacle->height);
-        } else {
-            graphics_fill_rectangle(cr, obstacle->x, obstacle->y, obstacle->width, obstacle->height);
-            graphics_set_color(cr, COLOR_YELLOW);
-            graphics_draw_rectangle(cr, obstacle->x, obstacle->y, obstacle->width, obstacle->height);
-            graphics_set_color(cr, COLOR_RED);
+static void obstacle_atlas_clear(ObstacleAtlas *atlas) {
+    if (atlas->pattern) cairo_pattern_destroy(atlas->pattern);
+    if (atlas->surface) cairo_surface_destroy(atlas->surface);
+    if (atlas->sources) g_ptr_array_free(atlas->sources, TRUE);
+    g_free(atlas->bucket_start);
+    g_free(atlas->order);
+    memset(atlas, 0, sizeof(*atlas));
+}
+
+// Built for exactly these templates (same pixbufs, same order) at this scale
+static gboolean obstacle_atlas_matches(const ObstacleAtlas *atlas, GPtrArray *templates, gdouble scale) {
+    if (!atlas->bucket_start || atlas->scale != scale || atlas->templates != templates->len) return FALSE;
+    for (guint t = 0; t < templates->len; t++) {
+        if (g_ptr_array_index(atlas->sources, t) != g_ptr_array_index(templates, t)) return FALSE;
+    }
+    return TRUE;
+}
+
+/* Lay out one column per template and one row per size class (in game
+   units), then resample every sprite into its cell once at cr's scale */
+static void obstacle_atlas_build(ObstacleAtlas *atlas, GPtrArray *templates, cairo_t *cr) {
+    obstacle_atlas_clear(atlas);
+    atlas->templates = templates->len;
+    atlas->sources = g_ptr_array_new_with_free_func(g_object_unref);
+    for (guint t = 0; t < templates->len; t++) {
+        g_ptr_array_add(atlas->sources, g_object_ref(g_ptr_array_index(templates, t)));
+    }
+    atlas->scale = graphics_get_scale(cr);
+    atlas->bucket_start = g_new0(guint, templates->len * OBSTACLE_SIZE_CLASSES + 2);
+    if (templates->len == 0) return;
+
+    gint height = OBSTACLE_ATLAS_PADDING;
+    atlas->column_width = 0;
+    for (guint c = 0; c < OBSTACLE_SIZE_CLASSES; c++) {
+        atlas->cell_w[c] = (gint)(obstacle_base_size[c][0] * OBSTACLE_SIZE_SCALE);
+        atlas->cell_h[c] = (gint)(obstacle_base_size[c][1] * OBSTACLE_SIZE_SCALE);
+        atlas->row_y[c] = height;
+        height += atlas->cell_h[c] + OBSTACLE_ATLAS_PADDING;
+        atlas->column_width = MAX(atlas->column_width, atlas->cell_w[c] + OBSTACLE_ATLAS_PADDING);
+    }
+    gint width = OBSTACLE_ATLAS_PADDING + (gint)templates->len * atlas->column_width;
+
+    TRACE_BEGIN(trace, "obstacle_atlas_build");
+    atlas->surface = graphics_surface_create_similar_scaled(cr, CAIRO_CONTENT_COLOR_ALPHA, width, height);
+    cairo_t *acr = cairo_create(atlas->surface);
+    cairo_set_operator(acr, CAIRO_OPERATOR_SOURCE);
+    for (guint t = 0; t < templates->len; t++) {
+        for (guint c = 0; c < OBSTACLE_SIZE_CLASSES; c++) {
+            cairo_surface_t *image = graphics_image_surface_for_pixbuf_scaled(g_ptr_array_index(templates, t), atlas->cell_w[c],
+                                                                               atlas->cell_h[c], atlas->scale);
+            if (!image) continue;
+            cairo_set_source_surface(acr, image, OBSTACLE_ATLAS_PADDING + (gint)t * atlas->column_width, atlas->row_y[c]);
+            cairo_paint(acr);
+            cairo_surface_destroy(image);
+        }
+    }
+    cairo_destroy(acr);
+    atlas->pattern = cairo_pattern_create_for_surface(atlas->surface);
+    TRACE_END(trace);
+}
+
+// Atlas region of obstacle i, or -1 if it has no sprite or is not drawn at a size class
+static gint obstacle_atlas_region(const ObstacleAtlas *atlas, const ObstaclePool *pool, guint i) {
+    if (pool->sprite_id[i] < 0 || !atlas->surface) return -1;
+    gint w = (gint)pool->w[i], h = (gint)pool->h[i];
+    for (guint c = 0; c < OBSTACLE_SIZE_CLASSES; c++) {
+        if (w == atlas->cell_w[c] && h == atlas->cell_h[c]) {
+            return (gint)(c * atlas->templates) + pool->sprite_id[i];
         }
     }
+    return -1;
+}
+
+// Obstacles off the atlas: odd sizes go through the sprite cache, sprite-less ones are boxes
+static void draw_obstacle_fallback(ObstacleManager *manager, cairo_t *cr, guint i, gdouble y) {
+    const ObstaclePool *pool = &manager->pool;
+    if (pool->sprite_id[i] >= 0) {
+        GdkPixbuf *sprite = g_ptr_array_index(manager->sprite_templates, pool->sprite_id[i]);
+        graphics_draw_pixbuf(cr, sprite, pool->x[i], y, pool->w[i], pool->h[i]);
+    } else {
+        graphics_set_color(cr, COLOR_RED);
+        graphics_fill_rectangle(cr, pool->x[i], y, pool->w[i], pool->h[i]);
+        graphics_set_color(cr, COLOR_YELLOW);
+        graphics_draw_rectangle(cr, pool->x[i], y, pool->w[i], pool->h[i]);
+    }
+}
+
+/* alpha blends from the previous tick (0) to the current one (1).
+   Obstacles still above the screen (they spawn at -h - 10) are skipped; the
+   rest are bucketed by atlas region with a counting sort and painted from the
+   atlas pattern, only its offset changing between blits. */
+void obstacle_manager_draw(ObstacleManager *manager, cairo_t *cr, gdouble alpha) {
+    const ObstaclePool *pool = &manager->pool;
+    ObstacleAtlas *atlas = &manager->atlas;
+    if (!obstacle_atlas_matches(atlas, manager->sprite_templates, graphics_get_scale(cr))) {
+        obstacle_atlas_build(atlas, manager->sprite_templates, cr);
+    }
+    if (atlas->order_capacity < pool->count) {
+        atlas->order_capacity = pool->capacity;
+        atlas->order = g_renew(guint, atlas->order, atlas->order_capacity);
+    }
+
+    guint regions = atlas->templates * OBSTACLE_SIZE_CLASSES;
+    guint *start = atlas->bucket_start;     // start[b + 1] counts bucket b, then becomes its end
+    memset(start, 0, (regions + 2) * sizeof(guint));
+    for (guint i = 0; i < pool->count; i++) {
+        gdouble y = pool->prev_y[i] + (pool->y[i] - pool->prev_y[i]) * alpha;
+        if (y + pool->h[i] <= 0.0 || y >= GAME_HEIGHT) continue;
+        gint region = obstacle_atlas_region(atlas, pool, i);
+        start[(region >= 0 ? (guint)region : regions) + 1]++;
+    }
+    for (guint b = 1; b <= regions + 1; b++) {
+        start[b] += start[b - 1];
+    }
+    guint visible = start[regions + 1];
+    for (guint i = 0; i < pool->count; i++) {
+        gdouble y = pool->prev_y[i] + (pool->y[i] - pool->prev_y[i]) * alpha;
+        if (y + pool->h[i] <= 0.0 || y >= GAME_HEIGHT) continue;
+        gint region = obstacle_atlas_region(atlas, pool, i);
+        atlas->order[start[region >= 0 ? (guint)region : regions]++] = i;
+    }
+    // Each start[b] now holds the end of bucket b; atlas buckets are [0, start[regions - 1])
+    guint atlas_end = regions > 0 ? start[regions - 1] : 0;
+
+    cairo_save(cr);
+    cairo_rectangle(cr, 0, 0, GAME_WIDTH, GAME_HEIGHT);
+    cairo_clip(cr);
+    if (atlas_end > 0) {
+        cairo_set_source(cr, atlas->pattern);
+        for (guint k = 0; k < atlas_end; k++) {
+            guint i = atlas->order[k];
+            guint region = (guint)obstacle_atlas_region(atlas, pool, i);
+            guint c = region / atlas->templates, t = region % atlas->templates;
+            gdouble y = pool->prev_y[i] + (pool->y[i] - pool->prev_y[i]) * alpha;
+            cairo_matrix_t offset;
+            cairo_matrix_init_translate(&offset, OBSTACLE_ATLAS_PADDING + (gint)t * atlas->column_width - pool->x[i],
+                                        atlas->row_y[c] - y);
+            cairo_pattern_set_matrix(atlas->pattern, &offset);
+            cairo_rectangle(cr, pool->x[i], y, atlas->cell_w[c], atlas->cell_h[c]);
+            cairo_fill(cr);
+        }
+    }
+    for (guint k = atlas_end; k < visible; k++) {
+        guint i = atlas->order[k];
+        draw_obstacle_fallback(manager, cr, i, pool->prev_y[i] + (pool->y[i] - pool->prev_y[i]) * alpha);
+    }
+    cairo_restore(cr);
 }
 
 void obstacle_free(Obstacle *obstacle) {
@@ -112,12 +417,18 @@ void obstacle_free(Obstacle *obstacle) {
     g_free(obstacle);
 }
 
+/* Move from's atlas (and its draw scratch) to manager, which replaces it for
+   a new run; the next draw keeps it if the templates and scale still match */
+void obstacle_manager_take_atlas(ObstacleManager *manager, ObstacleManager *from) {
+    obstacle_atlas_clear(&manager->atlas);
+    manager->atlas = from->atlas;
+    memset(&from->atlas, 0, sizeof(from->atlas));
+}
+
 void obstacle_manager_free(ObstacleManager *manager) {
-    for (guint i = 0; i < manager->obstacles->len; i++) {
-        Obstacle *obstacle = g_ptr_array_index(manager->obstacles, i);
-        obstacle_free(obstacle);
-    }
-    g_ptr_array_free(manager->obstacles, TRUE);
+    obstacle_pool_clear(&manager->pool);
+    spatial_grid_free(manager->grid);
+    obstacle_atlas_clear(&manager->atlas);
     if (manager->sprite_templates) {
         for (guint i = 0; i < manager->sprite_templates->len; i++) {
             GdkPixbuf *pb = g_ptr_array_index(manager->sprite_templates, i);
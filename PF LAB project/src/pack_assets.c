@@ -0,0 +1,112 @@
+/* Build the asset pack the game maps at startup instead of decoding PNGs.
+
+   Every PNG in the assets directory is decoded, scaled bilinearly (the same
+   filter the game uses at runtime) to each size it is drawn at and stored as
+   premultiplied ARGB32:
+     background*.png   the window, GAME_WIDTH x GAME_HEIGHT
+     car*.png          the player, PLAYER_WIDTH x PLAYER_HEIGHT
+     obj_*.png         one image per obstacle size class
+   each at every render scale in pack_scales (1x, and 2x for HiDPI windows;
+   other scales are resampled at runtime). Other files are skipped. Rerun
+   after changing an image or one of those sizes; a missing or stale-format
+   pack makes the game fall back to the PNGs.
+
+   Usage: pack_assets <assets_dir> <output.pack>   (e.g. ../assets ../assets/assets.pack) */
+#include <gdk-pixbuf/gdk-pixbuf.h>
+#include <glib.h>
+#include <string.h>
+#include "asset_pack.h"
+#include "graphics.h"
+#include "sim.h"
+#include "player.h"
+#include "obstacle.h"
+
+// Render scales stored; the loader matches packed images by pixel size
+static const gint pack_scales[] = {1, 2};
+
+static void add_size(AssetPackWriter *writer, const gchar *name, GdkPixbuf *pixbuf, gint width, gint height) {
+    for (guint s = 0; s < G_N_ELEMENTS(pack_scales); s++) {
+        gint pixel_width = width * pack_scales[s], pixel_height = height * pack_scales[s];
+        cairo_surface_t *image = graphics_image_surface_for_pixbuf(pixbuf, pixel_width, pixel_height);
+        if (!image) continue;
+        asset_pack_writer_add(writer, name, image);
+        cairo_surface_destroy(image);
+        g_print("  %-24s %4d x %-4d (%dx)\n", name, pixel_width, pixel_height, pack_scales[s]);
+    }
+}
+
+// Sorted so the pack is byte-identical for the same inputs
+static gint compare_names(gconstpointer a, gconstpointer b) {
+    return strcmp(*(const gchar * const *)a, *(const gchar * const *)b);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        g_printerr("Usage: %s <assets_dir> <output.pack>\n", argv[0]);
+        return 1;
+    }
+
+    const char *dir_path = argv[1];
+    const char *out = argv[2];
+    GError *error = NULL;
+
+    GDir *dir = g_dir_open(dir_path, 0, &error);
+    if (!dir) {
+        g_printerr("Failed to open %s: %s\n", dir_path, error->message);
+        g_error_free(error);
+        return 2;
+    }
+    GPtrArray *names = g_ptr_array_new_with_free_func(g_free);
+    const gchar *entry;
+    while ((entry = g_dir_read_name(dir)) != NULL) {
+        if (g_str_has_suffix(entry, ".png")) g_ptr_array_add(names, g_strdup(entry));
+    }
+    g_dir_close(dir);
+    g_ptr_array_sort(names, compare_names);
+
+    AssetPackWriter *writer = asset_pack_writer_new();
+    for (guint i = 0; i < names->len; i++) {
+        const gchar *name = g_ptr_array_index(names, i);
+        gboolean background = g_str_has_prefix(name, "background");
+        gboolean car = g_str_has_prefix(name, "car");
+        gboolean obstacle = g_str_has_prefix(name, "obj_");
+        if (!background && !car && !obstacle) continue;
+        if (strlen(name) >= ASSET_PACK_NAME_SIZE) {
+            g_printerr("Skipping %s: name longer than %d characters\n", name, ASSET_PACK_NAME_SIZE - 1);
+            continue;
+        }
+
+        gchar *path = g_build_filename(dir_path, name, NULL);
+        GdkPixbuf *pixbuf = gdk_pixbuf_new_from_file(path, &error);
+        g_free(path);
+        if (!pixbuf) {
+            g_printerr("Failed to load %s: %s\n", name, error->message);
+            g_clear_error(&error);
+            continue;
+        }
+
+        if (background) {
+            add_size(writer, name, pixbuf, GAME_WIDTH, GAME_HEIGHT);
+        } else if (car) {
+            add_size(writer, name, pixbuf, (gint)PLAYER_WIDTH, (gint)PLAYER_HEIGHT);
+        } else {
+            for (guint c = 0; c < OBSTACLE_SIZE_CLASSES; c++) {
+                add_size(writer, name, pixbuf, (gint)(obstacle_base_size[c][0] * OBSTACLE_SIZE_SCALE),
+                         (gint)(obstacle_base_size[c][1] * OBSTACLE_SIZE_SCALE));
+            }
+        }
+        g_object_unref(pixbuf);
+    }
+    g_ptr_array_free(names, TRUE);
+
+    gint status = 0;
+    if (asset_pack_writer_save(writer, out, &error)) {
+        g_print("Saved asset pack to %s\n", out);
+    } else {
+        g_printerr("Failed to save %s: %s\n", out, error->message);
+        g_error_free(error);
+        status = 3;
+    }
+    asset_pack_writer_free(writer);
+    return status;
+}
@@ -10,21 +10,31 @@
 #define FRICTION 3.0             // exponential damping per second (unchanged)
 #define MAX_SPEED 1000.0         // maximum velocity magnitude (was 800.0; +25%)
 
+// Room above/below the body in the upright surface for the front indicator
+#define INDICATOR_PAD 8
+
+static void player_build_render_cache(Player *player, gdouble scale);
+
 Player* player_new(gdouble start_x, gdouble start_y, GdkPixbuf *sprite) {
-    Player *player = g_malloc(sizeof(Player));
+    Player *player = g_malloc0(sizeof(Player));
     player->x = start_x;
     player->y = start_y;
     /* Increase player size by ~35% for better visibility */
-    player->width = (gdouble)(50 * 1.35);
-    player->height = (gdouble)(60 * 1.35);
+    player->width = (gdouble)PLAYER_WIDTH;
+    player->height = (gdouble)PLAYER_HEIGHT;
     player->velocity_x = 0.0;
     player->velocity_y = 0.0;
     player->speed = 0.0;
     player->max_speed = MAX_SPEED;
     player->angle = -M_PI / 2.0;  // Start facing up
+    player->prev_x = player->x;
+    player->prev_y = player->y;
+    player->prev_angle = player->angle;
     player->angular_velocity = 0.0;
     player->lateral_damping = 0.0;
     player->sprite = sprite ? g_object_ref(sprite) : NULL;
+    player->render_quality = PLAYER_QUALITY_ATLAS;
+    /* Render cache is built on the first player_draw, so headless runs never pay for it */
     return player;
 }
 
@@ -87,94 +97,88 @@ void player_stop_y(Player *player) {
     // No-op; friction handled in update
 }
 
-void player_draw(Player *player, cairo_t *cr) {
-    if (!player) return;
-
-    gdouble cx = player->x + player->width / 2.0;
-    gdouble cy = player->y + player->height / 2.0;
-
-    cairo_save(cr);
-    cairo_translate(cr, cx, cy);
-    cairo_rotate(cr, player->angle);
-    cairo_translate(cr, -player->width / 2.0, -player->height / 2.0);
+// Procedural red car used when no sprite image is available (50x60 local units)
+static void draw_procedural_car(cairo_t *cr) {
+    // Draw red car from scratch (realistic top-down view)
+    // Main body (red)
+    cairo_set_source_rgb(cr, 0.85, 0.05, 0.05);  // Dark red
+    
+    // Car body outline (rounded rectangle shape)
+    cairo_move_to(cr, 10, 5);
+    cairo_line_to(cr, 40, 5);
+    cairo_arc(cr, 40, 10, 5, -M_PI/2, 0);
+    cairo_line_to(cr, 45, 50);
+    cairo_arc(cr, 40, 55, 5, 0, M_PI/2);
+    cairo_line_to(cr, 10, 60);
+    cairo_arc(cr, 10, 55, 5, M_PI/2, M_PI);
+    cairo_line_to(cr, 5, 10);
+    cairo_arc(cr, 10, 5, 5, M_PI, 3*M_PI/2);
+    cairo_close_path(cr);
+    cairo_fill(cr);
+    
+    // Windshield (front window - light blue-gray)
+    cairo_set_source_rgb(cr, 0.6, 0.7, 0.85);
+    cairo_move_to(cr, 12, 8);
+    cairo_line_to(cr, 38, 8);
+    cairo_line_to(cr, 36, 20);
+    cairo_line_to(cr, 14, 20);
+    cairo_close_path(cr);
+    cairo_fill(cr);
+    
+    // Rear window (darker blue-gray)
+    cairo_set_source_rgb(cr, 0.5, 0.6, 0.75);
+    cairo_rectangle(cr, 11, 40, 28, 12);
+    cairo_fill(cr);
+    
+    // Left headlight (yellow)
+    cairo_set_source_rgb(cr, 1.0, 0.9, 0.2);
+    cairo_arc(cr, 15, 6, 2.5, 0, 2 * M_PI);
+    cairo_fill(cr);
+    
+    // Right headlight (yellow)
+    cairo_arc(cr, 35, 6, 2.5, 0, 2 * M_PI);
+    cairo_fill(cr);
+    
+    // Left wheel (dark gray/black)
+    cairo_set_source_rgb(cr, 0.1, 0.1, 0.1);
+    cairo_arc(cr, 15, 18, 6, 0, 2 * M_PI);
+    cairo_fill(cr);
+    
+    // Left wheel rim (lighter gray)
+    cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
+    cairo_arc(cr, 15, 18, 3.5, 0, 2 * M_PI);
+    cairo_fill(cr);
+    
+    // Right wheel (dark gray/black)
+    cairo_set_source_rgb(cr, 0.1, 0.1, 0.1);
+    cairo_arc(cr, 35, 18, 6, 0, 2 * M_PI);
+    cairo_fill(cr);
+    
+    // Right wheel rim (lighter gray)
+    cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
+    cairo_arc(cr, 35, 18, 3.5, 0, 2 * M_PI);
+    cairo_fill(cr);
+    
+    // Rear lights (red)
+    cairo_set_source_rgb(cr, 0.9, 0.1, 0.1);
+    cairo_arc(cr, 15, 58, 2, 0, 2 * M_PI);
+    cairo_fill(cr);
+    cairo_arc(cr, 35, 58, 2, 0, 2 * M_PI);
+    cairo_fill(cr);
+}
 
+// Body (sprite or procedural car) plus the yellow front indicator, in local car space
+static void draw_car_body(Player *player, cairo_t *cr) {
     if (player->sprite) {
-        GdkPixbuf *scaled = gdk_pixbuf_scale_simple(player->sprite, 
-                                                     (gint)player->width, 
-                                                     (gint)player->height, 
-                                                     GDK_INTERP_BILINEAR);
-        if (scaled) {
-            gdk_cairo_set_source_pixbuf(cr, scaled, 0, 0);
+        cairo_surface_t *image = graphics_image_surface_for_pixbuf_scaled(player->sprite, (gint)player->width, (gint)player->height,
+                                                                           player->render_scale);
+        if (image) {
+            cairo_set_source_surface(cr, image, 0, 0);
             cairo_paint(cr);
-            g_object_unref(scaled);
+            cairo_surface_destroy(image);
         }
     } else {
-        // Draw red car from scratch (realistic top-down view)
-        // Main body (red)
-        cairo_set_source_rgb(cr, 0.85, 0.05, 0.05);  // Dark red
-        
-        // Car body outline (rounded rectangle shape)
-        cairo_move_to(cr, 10, 5);
-        cairo_line_to(cr, 40, 5);
-        cairo_arc(cr, 40, 10, 5, -M_PI/2, 0);
-        cairo_line_to(cr, 45, 50);
-        cairo_arc(cr, 40, 55, 5, 0, M_PI/2);
-        cairo_line_to(cr, 10, 60);
-        cairo_arc(cr, 10, 55, 5, M_PI/2, M_PI);
-        cairo_line_to(cr, 5, 10);
-        cairo_arc(cr, 10, 5, 5, M_PI, 3*M_PI/2);
-        cairo_close_path(cr);
-        cairo_fill(cr);
-        
-        // Windshield (front window - light blue-gray)
-        cairo_set_source_rgb(cr, 0.6, 0.7, 0.85);
-        cairo_move_to(cr, 12, 8);
-        cairo_line_to(cr, 38, 8);
-        cairo_line_to(cr, 36, 20);
-        cairo_line_to(cr, 14, 20);
-        cairo_close_path(cr);
-        cairo_fill(cr);
-        
-        // Rear window (darker blue-gray)
-        cairo_set_source_rgb(cr, 0.5, 0.6, 0.75);
-        cairo_rectangle(cr, 11, 40, 28, 12);
-        cairo_fill(cr);
-        
-        // Left headlight (yellow)
-        cairo_set_source_rgb(cr, 1.0, 0.9, 0.2);
-        cairo_arc(cr, 15, 6, 2.5, 0, 2 * M_PI);
-        cairo_fill(cr);
-        
-        // Right headlight (yellow)
-        cairo_arc(cr, 35, 6, 2.5, 0, 2 * M_PI);
-        cairo_fill(cr);
-        
-        // Left wheel (dark gray/black)
-        cairo_set_source_rgb(cr, 0.1, 0.1, 0.1);
-        cairo_arc(cr, 15, 18, 6, 0, 2 * M_PI);
-        cairo_fill(cr);
-        
-        // Left wheel rim (lighter gray)
-        cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
-        cairo_arc(cr, 15, 18, 3.5, 0, 2 * M_PI);
-        cairo_fill(cr);
-        
-        // Right wheel (dark gray/black)
-        cairo_set_source_rgb(cr, 0.1, 0.1, 0.1);
-        cairo_arc(cr, 35, 18, 6, 0, 2 * M_PI);
-        cairo_fill(cr);
-        
-        // Right wheel rim (lighter gray)
-        cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
-        cairo_arc(cr, 35, 18, 3.5, 0, 2 * M_PI);
-        cairo_fill(cr);
-        
-        // Rear lights (red)
-        cairo_set_source_rgb(cr, 0.9, 0.1, 0.1);
-        cairo_arc(cr, 15, 58, 2, 0, 2 * M_PI);
-        cairo_fill(cr);
-        cairo_arc(cr, 35, 58, 2, 0, 2 * M_PI);
-        cairo_fill(cr);
+        draw_procedural_car(cr);
     }
 
     // Front indicator (yellow triangle at top of car)
@@ -186,8 +190,114 @@ void player_draw(Player *player, cairo_t *cr) {
     cairo_close_path(cr);
     cairo_fill(cr);
     cairo_restore(cr);
+}
 
-    cairo_restore(cr);
+static void player_free_render_cache(Player *player) {
+    if (player->upright) {
+        cairo_surface_destroy(player->upright);
+        player->upright = NULL;
+    }
+    for (gint i = 0; i < PLAYER_ATLAS_FRAMES; i++) {
+        if (player->atlas[i]) cairo_surface_destroy(player->atlas[i]);
+        player->atlas[i] = NULL;
+    }
+}
+
+/* Scale/tessellate the car once into an upright surface, then bake
+   PLAYER_ATLAS_FRAMES rotations of it so drawing is a single blit. Sizes are
+   in game units; the surfaces hold scale device pixels per unit. */
+static void player_build_render_cache(Player *player, gdouble scale) {
+    player_free_render_cache(player);
+    player->render_scale = scale;
+    gint uw = (gint)ceil(player->width);
+    gint uh = (gint)ceil(player->height) + 2 * INDICATOR_PAD;
+
+    player->upright = graphics_image_surface_create_scaled(CAIRO_FORMAT_ARGB32, uw, uh, scale);
+    cairo_t *cr = cairo_create(player->upright);
+    cairo_translate(cr, 0, INDICATOR_PAD);
+    draw_car_body(player, cr);
+    cairo_destroy(cr);
+
+    /* Square frames large enough to hold the upright surface at any angle */
+    player->atlas_size = (gint)ceil(sqrt((gdouble)(uw * uw + uh * uh))) + 2;
+    for (gint i = 0; i < PLAYER_ATLAS_FRAMES; i++) {
+        gdouble angle = (2.0 * M_PI * i) / PLAYER_ATLAS_FRAMES;
+        player->atlas[i] = graphics_image_surface_create_scaled(CAIRO_FORMAT_ARGB32, player->atlas_size, player->atlas_size, scale);
+        cr = cairo_create(player->atlas[i]);
+        cairo_translate(cr, player->atlas_size / 2.0, player->atlas_size / 2.0);
+        cairo_rotate(cr, angle);
+        cairo_set_source_surface(cr, player->upright, -player->width / 2.0, -player->height / 2.0 - INDICATOR_PAD);
+        cairo_paint(cr);
+        cairo_destroy(cr);
+    }
+}
+
+void player_set_render_quality(Player *player, PlayerRenderQuality quality) {
+    if (!player) return;
+    player->render_quality = quality;
+}
+
+/* Copy everything player_draw reads except the sprite and its caches, so a
+   render-side copy keeps its own caches across snapshots */
+void player_copy_state(Player *dst, const Player *src) {
+    dst->x = src->x;
+    dst->y = src->y;
+    dst->width = src->width;
+    dst->height = src->height;
+    dst->velocity_x = src->velocity_x;
+    dst->velocity_y = src->velocity_y;
+    dst->speed = src->speed;
+    dst->max_speed = src->max_speed;
+    dst->angle = src->angle;
+    dst->prev_x = src->prev_x;
+    dst->prev_y = src->prev_y;
+    dst->prev_angle = src->prev_angle;
+    dst->angular_velocity = src->angular_velocity;
+    dst->lateral_damping = src->lateral_damping;
+    dst->render_quality = src->render_quality;
+}
+
+// Remember the current state so rendering can blend towards the next tick
+void player_save_previous_state(Player *player) {
+    if (!player) return;
+    player->prev_x = player->x;
+    player->prev_y = player->y;
+    player->prev_angle = player->angle;
+}
+
+// alpha blends from the previous tick (0) to the current one (1)
+void player_draw(Player *player, cairo_t *cr, gdouble alpha) {
+    if (!player) return;
+    gdouble scale = graphics_get_scale(cr);
+    if (!player->upright || player->render_scale != scale) player_build_render_cache(player, scale);
+
+    gdouble x = player->prev_x + (player->x - player->prev_x) * alpha;
+    gdouble y = player->prev_y + (player->y - player->prev_y) * alpha;
+    /* Interpolate the heading along the shortest arc (angle wraps at +-PI) */
+    gdouble turn = player->angle - player->prev_angle;
+    if (turn > M_PI) turn -= 2.0 * M_PI;
+    if (turn < -M_PI) turn += 2.0 * M_PI;
+    gdouble angle = player->prev_angle + turn * alpha;
+
+    gdouble cx = x + player->width / 2.0;
+    gdouble cy = y + player->height / 2.0;
+
+    if (player->render_quality == PLAYER_QUALITY_EXACT) {
+        cairo_save(cr);
+        cairo_translate(cr, cx, cy);
+        cairo_rotate(cr, angle);
+        cairo_set_source_surface(cr, player->upright, -player->width / 2.0, -player->height / 2.0 - INDICATOR_PAD);
+        cairo_paint(cr);
+        cairo_restore(cr);
+        return;
+    }
+
+    // Pick the nearest pre-rotated frame for the current heading
+    gint frame = (gint)lround(angle / (2.0 * M_PI) * PLAYER_ATLAS_FRAMES) % PLAYER_ATLAS_FRAMES;
+    if (frame < 0) frame += PLAYER_ATLAS_FRAMES;
+
+    cairo_set_source_surface(cr, player->atlas[frame], cx - player->atlas_size / 2.0, cy - player->atlas_size / 2.0);
+    cairo_paint(cr);
 }
 
 void player_free(Player *player) {
@@ -195,5 +305,6 @@ void player_free(Player *player) {
     if (player->sprite) {
         g_object_unref(player->sprite);
     }
+    player_free_render_cache(player);
     g_free(player);
 }
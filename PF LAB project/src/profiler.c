@@ -0,0 +1,143 @@
+#include "profiler.h"
+
+#ifdef PROFILER_ENABLED
+
+#include <stdlib.h>
+#include <string.h>
+#include "graphics.h"
+#include "compare.h"
+
+#define OVERLAY_WIDTH 372.0
+#define OVERLAY_HEIGHT 168.0
+#define GRAPH_HEIGHT 80.0
+#define GRAPH_MAX_MS 50.0            // graph top; taller bars are clipped
+#define DEFAULT_REFRESH_US 16667     // when the frame clock reports no refresh rate
+
+/* Single-producer ring: the GTK thread fills `pending` during a frame and
+   publishes it at the start of the next one by writing the slot, then bumping
+   `published` with a full barrier. A reader on any thread loads `published`
+   first and only touches the newest PROFILER_WINDOW_FRAMES slots, which the
+   writer will not reuse for another RING_SIZE - WINDOW frames. */
+static ProfilerFrame ring[PROFILER_RING_SIZE];
+static volatile gint published = 0;
+static ProfilerFrame pending;
+static gboolean pending_open = FALSE;
+static gint64 last_frame_time = 0;
+static guint64 dropped_total = 0;
+static gboolean overlay_visible = FALSE;
+
+void profiler_frame_begin(gint64 frame_time_us, gint64 refresh_interval_us) {
+    if (pending_open) {
+        gint head = g_atomic_int_get(&published);
+        ring[head & (PROFILER_RING_SIZE - 1)] = pending;
+        g_atomic_int_set(&published, head + 1);
+    }
+
+    memset(&pending, 0, sizeof(pending));
+    pending_open = TRUE;
+    if (last_frame_time != 0) {
+        gint64 interval = frame_time_us - last_frame_time;
+        gint64 refresh = refresh_interval_us > 0 ? refresh_interval_us : DEFAULT_REFRESH_US;
+        /* A frame that took k refresh periods missed k - 1 of them */
+        gint64 periods = (interval + refresh / 2) / refresh;
+        pending.ms[PROFILER_PHASE_INTERVAL] = interval / 1000.0f;
+        pending.dropped = (guint16)CLAMP(periods - 1, 0, G_MAXUINT16);
+        dropped_total += pending.dropped;
+    }
+    last_frame_time = frame_time_us;
+}
+
+/* The frame clock was stopped (static screen); the gap before the next frame
+   is idle time, not missed refreshes */
+void profiler_frame_resume(void) {
+    last_frame_time = 0;
+}
+
+// Accumulate time into the current frame (phases may run several times per frame)
+void profiler_add(ProfilerPhase phase, gint64 elapsed_us) {
+    pending.ms[phase] += elapsed_us / 1000.0f;
+}
+
+void profiler_add_tick(void) {
+    pending.ticks++;
+}
+
+// Copy up to max_frames of the newest published frames, oldest first; returns how many
+guint profiler_read(ProfilerFrame *out, guint max_frames) {
+    gint head = g_atomic_int_get(&published);
+    guint n = MIN((guint)head, MIN(max_frames, PROFILER_WINDOW_FRAMES));
+    for (guint i = 0; i < n; i++) {
+        out[i] = ring[(head - n + i) & (PROFILER_RING_SIZE - 1)];
+    }
+    return n;
+}
+
+gboolean profiler_toggle(void) {
+    overlay_visible = !overlay_visible;
+    return overlay_visible;
+}
+
+// Nearest-rank percentiles p50/p95/p99 of one phase over the window
+static void phase_percentiles(const ProfilerFrame *frames, guint n, ProfilerPhase phase, gfloat out[3]) {
+    gfloat values[PROFILER_WINDOW_FRAMES];
+    static const gdouble ranks[3] = {0.50, 0.95, 0.99};
+    for (guint i = 0; i < n; i++) values[i] = frames[i].ms[phase];
+    qsort(values, n, sizeof(gfloat), compare_floats);
+    for (guint r = 0; r < 3; r++) {
+        guint rank = (guint)(ranks[r] * n + 0.999);
+        out[r] = values[CLAMP(rank, 1, n) - 1];
+    }
+}
+
+// Rolling frame-interval graph and percentile table with its top-left corner at (x, y)
+void profiler_draw(cairo_t *cr, gdouble x, gdouble y) {
+    if (!overlay_visible) return;
+
+    ProfilerFrame frames[PROFILER_WINDOW_FRAMES];
+    guint n = profiler_read(frames, PROFILER_WINDOW_FRAMES);
+
+    cairo_save(cr);
+    cairo_set_source_rgba(cr, 0.0, 0.0, 0.0, 0.7);
+    graphics_fill_rectangle(cr, x, y, OVERLAY_WIDTH, OVERLAY_HEIGHT);
+
+    /* Frame-interval bars: green on time, red when refreshes were missed */
+    gdouble graph_x = x + 6, graph_bottom = y + 6 + GRAPH_HEIGHT;
+    gdouble bar_width = (OVERLAY_WIDTH - 12) / PROFILER_WINDOW_FRAMES;
+    guint window_dropped = 0;
+    for (guint i = 0; i < n; i++) {
+        gdouble h = MIN(frames[i].ms[PROFILER_PHASE_INTERVAL] / GRAPH_MAX_MS, 1.0) * GRAPH_HEIGHT;
+        if (frames[i].dropped) {
+            cairo_set_source_rgb(cr, 0.9, 0.2, 0.2);
+            window_dropped += frames[i].dropped;
+        } else {
+            cairo_set_source_rgb(cr, 0.3, 0.8, 0.3);
+        }
+        graphics_fill_rectangle(cr, graph_x + i * bar_width, graph_bottom - h, bar_width, h);
+    }
+    /* 60 and 30 fps reference lines */
+    cairo_set_line_width(cr, 1.0);
+    cairo_set_source_rgba(cr, 1.0, 1.0, 1.0, 0.5);
+    for (gint fps = 60; fps >= 30; fps -= 30) {
+        gdouble ly = graph_bottom - (1000.0 / fps / GRAPH_MAX_MS) * GRAPH_HEIGHT;
+        cairo_move_to(cr, graph_x, ly);
+        cairo_line_to(cr, graph_x + OVERLAY_WIDTH - 12, ly);
+        cairo_stroke(cr);
+    }
+
+    static const gchar *labels[PROFILER_PHASE_COUNT] = {"input", "sim", "render", "frame"};
+    gchar line[128];
+    graphics_set_color(cr, COLOR_WHITE);
+    gdouble text_y = graph_bottom + 16;
+    for (gint phase = PROFILER_PHASE_COUNT - 1; phase >= 0 && n > 0; phase--) {
+        gfloat p[3];
+        phase_percentiles(frames, n, (ProfilerPhase)phase, p);
+        g_snprintf(line, sizeof(line), "%-6s p50 %6.2f  p95 %6.2f  p99 %6.2f ms", labels[phase], p[0], p[1], p[2]);
+        graphics_draw_text(cr, line, x + 6, text_y, 11);
+        text_y += 13;
+    }
+    g_snprintf(line, sizeof(line), "dropped %u in last %u frames, %" G_GUINT64_FORMAT " total", window_dropped, n, dropped_total);
+    graphics_draw_text(cr, line, x + 6, text_y, 11);
+    cairo_restore(cr);
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,201 @@
+#include "render_thread.h"
+#include "graphics.h"
+#include "trace.h"
+
+struct RenderThread {
+    cairo_surface_t *buffers[2];
+    gint buffer_width[2];       // size each buffer was made at; only the thread reads these
+    gint buffer_height[2];
+    gdouble buffer_scale[2];
+    gint front;                 // buffer holding the newest finished frame, -1 = none yet
+    guint64 front_serial;       // serial of the frame in the front buffer
+    GMutex lock;                // guards everything below, and the front buffer while it is painted
+    GCond cond;
+    gpointer pending;           // newest submitted frame not yet taken by the thread
+    guint64 pending_serial;
+    gint width;                 // size the next frame is drawn at
+    gint height;
+    gdouble scale;
+    gboolean busy;              // the thread is drawing a frame
+    gboolean quit;
+    RenderThreadStats stats;
+    gint64 render_us;
+    GSource *ready_source;      // pending "ready" notification, NULL once run
+    RenderThreadDrawFunc draw;
+    GDestroyNotify free_frame;
+    RenderThreadReadyFunc ready;
+    gpointer user_data;
+    GMainContext *context;      // where ready runs
+    GThread *thread;
+};
+
+// Main context: a new front buffer can be painted
+static gboolean notify_ready(gpointer data) {
+    RenderThread *thread = data;
+    g_mutex_lock(&thread->lock);
+    g_source_unref(thread->ready_source);
+    thread->ready_source = NULL;
+    g_mutex_unlock(&thread->lock);
+    if (thread->ready) thread->ready(thread->user_data);
+    return G_SOURCE_REMOVE;
+}
+
+static void render_buffer_create(RenderThread *thread, gint index, gint width, gint height, gdouble scale) {
+    if (thread->buffers[index]) cairo_surface_destroy(thread->buffers[index]);
+    thread->buffers[index] = graphics_image_surface_create_scaled(CAIRO_FORMAT_RGB24, width, height, scale);
+    thread->buffer_width[index] = width;
+    thread->buffer_height[index] = height;
+    thread->buffer_scale[index] = scale;
+}
+
+static gpointer render_thread_main(gpointer data) {
+    RenderThread *thread = data;
+    g_mutex_lock(&thread->lock);
+    for (;;) {
+        while (!thread->pending && !thread->quit) g_cond_wait(&thread->cond, &thread->lock);
+        if (!thread->pending) break;
+        gpointer frame = thread->pending;
+        guint64 serial = thread->pending_serial;
+        thread->pending = NULL;
+        thread->busy = TRUE;
+        // The back buffer: the paint side only ever reads the front one
+        gint back = thread->front == 0 ? 1 : 0;
+        gint width = thread->width, height = thread->height;
+        gdouble scale = thread->scale;
+        g_mutex_unlock(&thread->lock);
+
+        if (thread->buffer_width[back] != width || thread->buffer_height[back] != height || thread->buffer_scale[back] != scale) {
+            render_buffer_create(thread, back, width, height, scale);
+        }
+
+        TRACE_BEGIN(trace, "render_frame");
+        gint64 start = g_get_monotonic_time();
+        cairo_t *cr = cairo_create(thread->buffers[back]);
+        thread->draw(frame, cr, thread->user_data);
+        cairo_destroy(cr);
+        cairo_surface_flush(thread->buffers[back]);
+        thread->free_frame(frame);
+        gint64 elapsed = g_get_monotonic_time() - start;
+        TRACE_END(trace);
+
+        g_mutex_lock(&thread->lock);
+        thread->front = back;
+        thread->front_serial = serial;
+        thread->busy = FALSE;
+        thread->stats.rendered++;
+        thread->render_us += elapsed;
+        if (thread->ready && !thread->ready_source) {
+            thread->ready_source = g_idle_source_new();
+            g_source_set_priority(thread->ready_source, G_PRIORITY_HIGH_IDLE);
+            g_source_set_callback(thread->ready_source, notify_ready, thread, NULL);
+            g_source_attach(thread->ready_source, thread->context);
+        }
+        g_cond_broadcast(&thread->cond);
+    }
+    g_mutex_unlock(&thread->lock);
+    return NULL;
+}
+
+/* Start the thread with two width x height RGB24 buffers at scale device
+   pixels per unit. draw runs on the thread for every frame it renders;
+   free_frame releases frames after they are drawn or replaced; ready
+   (optional) runs on the calling thread's main context after each finished frame. */
+RenderThread* render_thread_new(gint width, gint height, gdouble scale, RenderThreadDrawFunc draw, GDestroyNotify free_frame,
+                                RenderThreadReadyFunc ready, gpointer user_data) {
+    RenderThread *thread = g_malloc0(sizeof(RenderThread));
+    for (guint i = 0; i < G_N_ELEMENTS(thread->buffers); i++) {
+        render_buffer_create(thread, i, width, height, scale);
+    }
+    thread->width = width;
+    thread->height = height;
+    thread->scale = scale;
+    thread->front = -1;
+    g_mutex_init(&thread->lock);
+    g_cond_init(&thread->cond);
+    thread->draw = draw;
+    thread->free_frame = free_frame;
+    thread->ready = ready;
+    thread->user_data = user_data;
+    thread->context = g_main_context_ref_thread_default();
+    thread->thread = g_thread_new("render", render_thread_main, thread);
+    return thread;
+}
+
+// Size of the frames drawn from the next one on (e.g. the window was resized or changed scale)
+void render_thread_resize(RenderThread *thread, gint width, gint height, gdouble scale) {
+    g_mutex_lock(&thread->lock);
+    thread->width = width;
+    thread->height = height;
+    thread->scale = scale;
+    g_mutex_unlock(&thread->lock);
+}
+
+// Hand a frame to the thread (ownership passes); serial is reported back by render_thread_paint
+void render_thread_submit(RenderThread *thread, gpointer frame, guint64 serial) {
+    g_mutex_lock(&thread->lock);
+    gpointer replaced = thread->pending;
+    thread->pending = frame;
+    thread->pending_serial = serial;
+    thread->stats.submitted++;
+    if (replaced) thread->stats.dropped++;
+    g_cond_broadcast(&thread->cond);
+    g_mutex_unlock(&thread->lock);
+    if (replaced) thread->free_frame(replaced);
+}
+
+/* Blit the newest finished frame at the origin of cr (in cr's units, so a
+   buffer at the window's scale lands 1:1 on its pixels). Returns its serial,
+   or 0 (and draws nothing) if no frame has finished yet. */
+guint64 render_thread_paint(RenderThread *thread, cairo_t *cr) {
+    g_mutex_lock(&thread->lock);
+    guint64 serial = 0;
+    if (thread->front >= 0) {
+        cairo_save(cr);
+        cairo_set_source_surface(cr, thread->buffers[thread->front], 0, 0);
+        cairo_set_operator(cr, CAIRO_OPERATOR_SOURCE);
+        cairo_paint(cr);
+        cairo_restore(cr);
+        serial = thread->front_serial;
+    }
+    g_mutex_unlock(&thread->lock);
+    return serial;
+}
+
+// Block until every submitted frame has been drawn (or replaced and drawn)
+void render_thread_flush(RenderThread *thread) {
+    g_mutex_lock(&thread->lock);
+    while (thread->pending || thread->busy) g_cond_wait(&thread->cond, &thread->lock);
+    g_mutex_unlock(&thread->lock);
+}
+
+void render_thread_get_stats(RenderThread *thread, RenderThreadStats *stats) {
+    g_mutex_lock(&thread->lock);
+    *stats = thread->stats;
+    stats->render_ms = thread->stats.rendered ? thread->render_us / 1000.0 / thread->stats.rendered : 0.0;
+    g_mutex_unlock(&thread->lock);
+}
+
+// Finish the frame in progress, drop any waiting one and stop the thread
+void render_thread_free(RenderThread *thread) {
+    if (!thread) return;
+    g_mutex_lock(&thread->lock);
+    gpointer dropped = thread->pending;
+    thread->pending = NULL;
+    thread->quit = TRUE;
+    g_cond_broadcast(&thread->cond);
+    g_mutex_unlock(&thread->lock);
+    if (dropped) thread->free_frame(dropped);
+    g_thread_join(thread->thread);
+
+    if (thread->ready_source) {
+        g_source_destroy(thread->ready_source);
+        g_source_unref(thread->ready_source);
+    }
+    g_main_context_unref(thread->context);
+    for (guint i = 0; i < G_N_ELEMENTS(thread->buffers); i++) {
+        cairo_surface_destroy(thread->buffers[i]);
+    }
+    g_cond_clear(&thread->cond);
+    g_mutex_clear(&thread->lock);
+    g_free(thread);
+}
@@ -0,0 +1,166 @@
+#include "replay.h"
+#include "byteorder.h"
+#include <math.h>
+#include <string.h>
+
+GQuark replay_error_quark(void) {
+    return g_quark_from_static_string("replay-error-quark");
+}
+
+// Close a run: input byte followed by its length as an unsigned LEB128 varint
+static void append_run(GByteArray *out, guint8 input, guint64 length) {
+    guint8 buf[11];
+    guint n = 0;
+    buf[n++] = input;
+    do {
+        guint8 byte = length & 0x7f;
+        length >>= 7;
+        buf[n++] = byte | (length ? 0x80 : 0);
+    } while (length);
+    g_byte_array_append(out, buf, n);
+}
+
+ReplayRecorder* replay_recorder_new(guint64 seed, gdouble tick_rate) {
+    ReplayRecorder *recorder = g_malloc0(sizeof(ReplayRecorder));
+    recorder->runs = g_byte_array_new();
+    recorder->seed = seed;
+    recorder->tick_rate = tick_rate;
+    return recorder;
+}
+
+// Record the input byte of the next tick (held keys rarely change, so runs are long)
+void replay_recorder_push(ReplayRecorder *recorder, guint8 tick_input) {
+    if (recorder->run_length > 0 && tick_input != recorder->run_input) {
+        append_run(recorder->runs, recorder->run_input, recorder->run_length);
+        recorder->run_length = 0;
+    }
+    recorder->run_input = tick_input;
+    recorder->run_length++;
+    recorder->tick_count++;
+}
+
+// Write header + runs (the open run included); the recorder can keep recording afterwards
+gboolean replay_recorder_save(ReplayRecorder *recorder, const gchar *path, gint final_score, guint32 flags, GError **error) {
+    GByteArray *out = g_byte_array_sized_new(REPLAY_HEADER_SIZE + recorder->runs->len + 11);
+    guint8 header[REPLAY_HEADER_SIZE];
+    guint64 rate_bits;
+    memcpy(&rate_bits, &recorder->tick_rate, sizeof(rate_bits));
+
+    memcpy(header, REPLAY_MAGIC, 4);
+    put_u16(header + 4, REPLAY_VERSION);
+    put_u16(header + 6, 0);
+    put_u64(header + 8, recorder->seed);
+    put_u64(header + 16, rate_bits);
+    put_u64(header + 24, recorder->tick_count);
+    put_u32(header + 32, (guint32)final_score);
+    put_u32(header + 36, flags);
+    g_byte_array_append(out, header, REPLAY_HEADER_SIZE);
+    g_byte_array_append(out, recorder->runs->data, recorder->runs->len);
+    if (recorder->run_length > 0) {
+        append_run(out, recorder->run_input, recorder->run_length);
+    }
+
+    gboolean ok = g_file_set_contents(path, (const gchar *)out->data, out->len, error);
+    g_byte_array_free(out, TRUE);
+    return ok;
+}
+
+void replay_recorder_free(ReplayRecorder *recorder) {
+    if (!recorder) return;
+    g_byte_array_free(recorder->runs, TRUE);
+    g_free(recorder);
+}
+
+/* Map the file and validate the header; runs are decoded lazily by replay_next,
+   so opening a long log costs the same as opening a short one */
+Replay* replay_open(const gchar *path, GError **error) {
+    GMappedFile *file = g_mapped_file_new(path, FALSE, error);
+    if (!file) return NULL;
+
+    const guint8 *data = (const guint8 *)g_mapped_file_get_contents(file);
+    gsize size = g_mapped_file_get_length(file);
+    if (size < REPLAY_HEADER_SIZE || memcmp(data, REPLAY_MAGIC, 4) != 0 || get_u16(data + 4) != REPLAY_VERSION) {
+        g_set_error(error, REPLAY_ERROR, REPLAY_ERROR_FORMAT, "%s is not a version %d replay", path, REPLAY_VERSION);
+        g_mapped_file_unref(file);
+        return NULL;
+    }
+
+    // A zero, negative or non-finite rate would make every tick's dt meaningless
+    guint64 rate_bits = get_u64(data + 16);
+    gdouble tick_rate;
+    memcpy(&tick_rate, &rate_bits, sizeof(rate_bits));
+    if (!isfinite(tick_rate) || tick_rate <= 0.0) {
+        g_set_error(error, REPLAY_ERROR, REPLAY_ERROR_FORMAT, "%s has an invalid tick rate", path);
+        g_mapped_file_unref(file);
+        return NULL;
+    }
+
+    Replay *replay = g_malloc0(sizeof(Replay));
+    replay->file = file;
+    replay->data = data;
+    replay->size = size;
+    replay->seed = get_u64(data + 8);
+    replay->tick_rate = tick_rate;
+    replay->tick_count = get_u64(data + 24);
+    replay->final_score = (gint)get_u32(data + 32);
+    replay->flags = get_u32(data + 36);
+    replay_rewind(replay);
+    return replay;
+}
+
+void replay_rewind(Replay *replay) {
+    replay->pos = REPLAY_HEADER_SIZE;
+    replay->run_left = 0;
+    replay->tick = 0;
+}
+
+// Input byte for the next tick; FALSE at the end of the log (or on a truncated run)
+gboolean replay_next(Replay *replay, guint8 *tick_input) {
+    if (replay->tick >= replay->tick_count) return FALSE;
+
+    while (replay->run_left == 0) {
+        if (replay->pos >= replay->size) return FALSE;
+        replay->run_input = replay->data[replay->pos++];
+        guint64 length = 0;
+        guint shift = 0;
+        guint8 byte;
+        do {
+            if (replay->pos >= replay->size || shift > 63) return FALSE;
+            byte = replay->data[replay->pos++];
+            length |= (guint64)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        replay->run_left = length;
+    }
+
+    replay->run_left--;
+    replay->tick++;
+    *tick_input = replay->run_input;
+    return TRUE;
+}
+
+/* Headless playback as fast as the core allows. Returns TRUE when the run
+   reproduces the recorded outcome (every tick decoded, same final score and
+   the same game-over state). */
+gboolean replay_run(Replay *replay, SimContext *sim) {
+    guint8 tick_input;
+    gdouble dt = 1.0 / replay->tick_rate;
+
+    replay_rewind(replay);
+    sim_set_seed(sim, replay->seed);
+    sim_reset(sim);
+    while (!sim_is_over(sim) && replay_next(replay, &tick_input)) {
+        sim_set_arcade_mode(sim, (tick_input & REPLAY_INPUT_ARCADE) != 0);
+        sim_step(sim, tick_input & ~REPLAY_INPUT_ARCADE, dt);
+    }
+
+    return replay->tick == replay->tick_count &&
+           sim_get_score(sim) == replay->final_score &&
+           sim_is_over(sim) == ((replay->flags & REPLAY_FLAG_GAME_OVER) != 0);
+}
+
+void replay_free(Replay *replay) {
+    if (!replay) return;
+    g_mapped_file_unref(replay->file);
+    g_free(replay);
+}
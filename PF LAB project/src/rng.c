@@ -0,0 +1,53 @@
+#include "rng.h"
+
+#define PCG32_MULTIPLIER G_GUINT64_CONSTANT(6364136223846793005)
+
+// Standard PCG32 seeding: the stream picks one of 2^63 independent sequences
+void rng_seed(Rng *rng, guint64 seed, guint64 stream) {
+    rng->state = 0;
+    rng->inc = (stream << 1) | 1u;
+    rng_next_u32(rng);
+    rng->state += seed;
+    rng_next_u32(rng);
+}
+
+guint32 rng_next_u32(Rng *rng) {
+    guint64 old = rng->state;
+    rng->state = old * PCG32_MULTIPLIER + rng->inc;
+    guint32 xorshifted = (guint32)(((old >> 18) ^ old) >> 27);
+    guint32 rot = (guint32)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+/* Uniform integer in [0, bound) without modulo bias (Lemire's multiply-shift
+   with rejection; the retry loop runs more than once with probability < bound/2^32).
+   bound == 0 returns 0. */
+guint32 rng_range(Rng *rng, guint32 bound) {
+    if (bound == 0) return 0;
+    guint64 m = (guint64)rng_next_u32(rng) * bound;
+    guint32 low = (guint32)m;
+    if (low < bound) {
+        guint32 threshold = -bound % bound;
+        while (low < threshold) {
+            m = (guint64)rng_next_u32(rng) * bound;
+            low = (guint32)m;
+        }
+    }
+    return (guint32)(m >> 32);
+}
+
+// Uniform double in [0, 1) with 53 random bits
+gdouble rng_next_double(Rng *rng) {
+    guint64 hi = rng_next_u32(rng) >> 5;
+    guint64 lo = rng_next_u32(rng) >> 6;
+    return (hi * 67108864.0 + lo) * (1.0 / 9007199254740992.0);
+}
+
+// Snapshots are plain copies; restoring one replays the exact same draws
+void rng_snapshot(const Rng *rng, Rng *out) {
+    *out = *rng;
+}
+
+void rng_restore(Rng *rng, const Rng *snapshot) {
+    *rng = *snapshot;
+}
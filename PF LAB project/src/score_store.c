@@ -0,0 +1,230 @@
+#include "score_store.h"
+#include "byteorder.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Writer thread commands; NULL cannot be queued
+#define SCORE_JOB_WRITE GINT_TO_POINTER(1)
+#define SCORE_JOB_QUIT GINT_TO_POINTER(2)
+
+struct ScoreStore {
+    gchar *path;
+    GMutex lock;                // guards everything below
+    GCond loaded_cond;
+    ScoreEntry entries[SCORE_STORE_MAX_ENTRIES];    // best first
+    guint count;
+    gboolean loaded;
+    GSource *loaded_source;     // pending "loaded" notification, NULL once run
+    ScoreStoreLoadedFunc loaded_func;
+    gpointer user_data;
+    GMainContext *context;      // where loaded_func runs
+    GAsyncQueue *jobs;
+    GThread *writer;
+};
+
+/* Sorted insert (lock held); equal scores keep the older entry first.
+   Returns the new entry's rank, or -1 if it did not make the table. */
+static gint table_insert(ScoreStore *store, const ScoreEntry *entry) {
+    guint rank = 0;
+    while (rank < store->count && store->entries[rank].score >= entry->score) rank++;
+    if (rank >= SCORE_STORE_MAX_ENTRIES) return -1;
+    guint moved = MIN(store->count, SCORE_STORE_MAX_ENTRIES - 1) - rank;
+    memmove(&store->entries[rank + 1], &store->entries[rank], moved * sizeof(ScoreEntry));
+    store->entries[rank] = *entry;
+    if (store->count < SCORE_STORE_MAX_ENTRIES) store->count++;
+    return (gint)rank;
+}
+
+/* Read the table file, or import the legacy single-number file if there is
+   none. Returns the number of entries parsed into out; *imported is set when
+   they came from the legacy file (the table should then be written). */
+static guint read_table(const gchar *path, ScoreEntry *out, gboolean *imported) {
+    gchar *data = NULL;
+    gsize size = 0;
+    *imported = FALSE;
+    if (g_file_get_contents(path, &data, &size, NULL)) {
+        const guint8 *p = (const guint8 *)data;
+        guint count = 0;
+        if (size >= SCORE_STORE_HEADER_SIZE && memcmp(p, SCORE_STORE_MAGIC, 4) == 0 && get_u16(p + 4) == SCORE_STORE_VERSION) {
+            count = MIN(get_u16(p + 6), SCORE_STORE_MAX_ENTRIES);
+            count = MIN(count, (size - SCORE_STORE_HEADER_SIZE) / SCORE_STORE_ENTRY_SIZE);
+            for (guint i = 0; i < count; i++) {
+                const guint8 *e = p + SCORE_STORE_HEADER_SIZE + i * SCORE_STORE_ENTRY_SIZE;
+                out[i].score = (gint)get_u32(e);
+                out[i].mode = get_u32(e + 4) <= SCORE_MODE_UNKNOWN ? (ScoreMode)get_u32(e + 4) : SCORE_MODE_UNKNOWN;
+                out[i].timestamp = (gint64)get_u64(e + 8);
+            }
+        } else {
+            g_warning("Ignoring %s: not a version %d score table", path, SCORE_STORE_VERSION);
+        }
+        g_free(data);
+        return count;
+    }
+
+    if (g_file_get_contents(SCORE_STORE_LEGACY_FILE, &data, NULL, NULL)) {
+        gint score = atoi(data);
+        g_free(data);
+        if (score > 0) {
+            out[0].score = score;
+            out[0].mode = SCORE_MODE_UNKNOWN;
+            out[0].timestamp = 0;
+            *imported = TRUE;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void write_table(ScoreStore *store) {
+    TRACE_BEGIN(trace, "score_store_write");
+    guint8 buf[SCORE_STORE_HEADER_SIZE + SCORE_STORE_MAX_ENTRIES * SCORE_STORE_ENTRY_SIZE];
+    g_mutex_lock(&store->lock);
+    guint count = store->count;
+    memcpy(buf, SCORE_STORE_MAGIC, 4);
+    put_u16(buf + 4, SCORE_STORE_VERSION);
+    put_u16(buf + 6, (guint16)count);
+    for (guint i = 0; i < count; i++) {
+        guint8 *e = buf + SCORE_STORE_HEADER_SIZE + i * SCORE_STORE_ENTRY_SIZE;
+        put_u32(e, (guint32)store->entries[i].score);
+        put_u32(e + 4, store->entries[i].mode);
+        put_u64(e + 8, (guint64)store->entries[i].timestamp);
+    }
+    g_mutex_unlock(&store->lock);
+
+    GError *error = NULL;
+    if (!g_file_set_contents(store->path, (const gchar *)buf, SCORE_STORE_HEADER_SIZE + count * SCORE_STORE_ENTRY_SIZE, &error)) {
+        g_warning("Failed to save scores: %s", error->message);
+        g_error_free(error);
+    }
+    TRACE_END(trace);
+}
+
+// Main context: tell the owner the table is complete
+static gboolean notify_loaded(gpointer data) {
+    ScoreStore *store = data;
+    g_mutex_lock(&store->lock);
+    g_source_unref(store->loaded_source);
+    store->loaded_source = NULL;
+    g_mutex_unlock(&store->lock);
+    if (store->loaded_func) store->loaded_func(store, store->user_data);
+    return G_SOURCE_REMOVE;
+}
+
+static void load_table(ScoreStore *store) {
+    TRACE_BEGIN(trace, "score_store_load");
+    ScoreEntry loaded[SCORE_STORE_MAX_ENTRIES];
+    gboolean imported;
+    guint count = read_table(store->path, loaded, &imported);
+
+    g_mutex_lock(&store->lock);
+    // Runs submitted while the file was being read are kept alongside it
+    for (guint i = 0; i < count; i++) {
+        table_insert(store, &loaded[i]);
+    }
+    store->loaded = TRUE;
+    g_cond_broadcast(&store->loaded_cond);
+    if (store->loaded_func) {
+        store->loaded_source = g_idle_source_new();
+        g_source_set_callback(store->loaded_source, notify_loaded, store, NULL);
+        g_source_attach(store->loaded_source, store->context);
+    }
+    g_mutex_unlock(&store->lock);
+
+    if (imported) g_async_queue_push(store->jobs, SCORE_JOB_WRITE);
+    TRACE_END(trace);
+}
+
+static gpointer writer_thread(gpointer data) {
+    ScoreStore *store = data;
+    load_table(store);
+    gboolean quit = FALSE;
+    while (!quit) {
+        // Everything queued since the last write collapses into one write of the latest table
+        gpointer job = g_async_queue_pop(store->jobs);
+        gboolean write = FALSE;
+        do {
+            if (job == SCORE_JOB_WRITE) write = TRUE;
+            if (job == SCORE_JOB_QUIT) quit = TRUE;
+        } while ((job = g_async_queue_try_pop(store->jobs)) != NULL);
+        if (write) write_table(store);
+    }
+    return NULL;
+}
+
+/* Start the writer thread, which reads path first; loaded (optional) runs on
+   the calling thread's main context afterwards. Until then the table holds
+   only runs submitted in the meantime. */
+ScoreStore* score_store_new(const gchar *path, ScoreStoreLoadedFunc loaded, gpointer user_data) {
+    ScoreStore *store = g_malloc0(sizeof(ScoreStore));
+    store->path = g_strdup(path);
+    g_mutex_init(&store->lock);
+    g_cond_init(&store->loaded_cond);
+    store->loaded_func = loaded;
+    store->user_data = user_data;
+    store->context = g_main_context_ref_thread_default();
+    store->jobs = g_async_queue_new();
+    store->writer = g_thread_new("score-store", writer_thread, store);
+    return store;
+}
+
+gboolean score_store_is_loaded(ScoreStore *store) {
+    g_mutex_lock(&store->lock);
+    gboolean loaded = store->loaded;
+    g_mutex_unlock(&store->lock);
+    return loaded;
+}
+
+// Block until the file has been read (tools and benchmarks without a main loop)
+void score_store_wait_loaded(ScoreStore *store) {
+    g_mutex_lock(&store->lock);
+    while (!store->loaded) g_cond_wait(&store->loaded_cond, &store->lock);
+    g_mutex_unlock(&store->lock);
+}
+
+/* Record a finished run stamped with the current time. Never waits for I/O:
+   the table is updated in memory and a write is queued if it changed.
+   Returns the run's rank (0 = new best), or -1 if it did not place. */
+gint score_store_submit(ScoreStore *store, gint score, ScoreMode mode) {
+    ScoreEntry entry = {score, mode, g_get_real_time() / G_USEC_PER_SEC};
+    g_mutex_lock(&store->lock);
+    gint rank = table_insert(store, &entry);
+    g_mutex_unlock(&store->lock);
+    if (rank >= 0) g_async_queue_push(store->jobs, SCORE_JOB_WRITE);
+    return rank;
+}
+
+// Best score so far (0 if none, or if the file has not been read yet)
+gint score_store_get_best(ScoreStore *store) {
+    g_mutex_lock(&store->lock);
+    gint best = store->count > 0 ? store->entries[0].score : 0;
+    g_mutex_unlock(&store->lock);
+    return best;
+}
+
+// Copy up to max_entries of the table, best first; returns how many were copied
+guint score_store_get_entries(ScoreStore *store, ScoreEntry *out, guint max_entries) {
+    g_mutex_lock(&store->lock);
+    guint n = MIN(store->count, max_entries);
+    memcpy(out, store->entries, n * sizeof(ScoreEntry));
+    g_mutex_unlock(&store->lock);
+    return n;
+}
+
+/* Finish every queued write, then stop the writer. This is the only call
+   that waits on the disk; make it at shutdown. */
+void score_store_free(ScoreStore *store) {
+    if (!store) return;
+    g_async_queue_push(store->jobs, SCORE_JOB_QUIT);
+    g_thread_join(store->writer);
+    if (store->loaded_source) {
+        g_source_destroy(store->loaded_source);
+        g_source_unref(store->loaded_source);
+    }
+    g_async_queue_unref(store->jobs);
+    g_main_context_unref(store->context);
+    g_cond_clear(&store->loaded_cond);
+    g_mutex_clear(&store->lock);
+    g_free(store->path);
+    g_free(store);
+}
@@ -0,0 +1,280 @@
+#include "sim.h"
+#include "collision.h"
+#include <math.h>
+#include <string.h>
+
+/* Obstacle count from which sim_step switches from a SIMD sweep of the
+   whole pool to the grid broad phase */
+#define BROAD_PHASE_MIN_OBSTACLES 64
+
+/* Score rate base (points per second) scaled by SPEEDUP_FACTOR */
+#define SCORE_RATE_BASE (60.0 * SPEEDUP_FACTOR)
+
+/* ============================================================================
+   EXPONENTIAL DIFFICULTY SYSTEM
+
+   The difficulty increases exponentially with score. This creates a smooth
+   progression from easy to extreme as the player survives longer. The curves
+   live in difficulty.c; each context reads them from a precomputed table.
+   ============================================================================ */
+
+/* Read the multipliers and stage for the current score from the table */
+void sim_update_difficulty(SimContext *sim) {
+    DifficultyLevel level;
+    difficulty_table_lookup(sim->difficulty, sim->score, &level);
+    sim->current_speed_multiplier = level.speed_multiplier;
+    sim->current_spawn_multiplier = level.spawn_multiplier;
+    sim->score_multiplier = level.score_multiplier;
+    sim->difficulty_stage = level.stage;
+}
+
+/* Push the current difficulty into the obstacle spawner */
+static void apply_difficulty(SimContext *sim) {
+    sim->obstacles->obstacle_speed = (DIFFICULTY_BASE_SPEED * SPEEDUP_FACTOR) * sim->current_speed_multiplier;
+    sim->obstacles->spawn_interval = (DIFFICULTY_BASE_SPAWN_INTERVAL / SPEEDUP_FACTOR) * sim->current_spawn_multiplier;
+}
+
+/* Get a description of the current difficulty stage */
+const gchar* sim_stage_name(gint stage) {
+    switch (stage) {
+        case 1: return "EASY";
+        case 2: return "MEDIUM";
+        case 3: return "HARD";
+        case 4: return "VERY HARD";
+        case 5: return "EXTREME";
+        default: return "?";
+    }
+}
+
+SimContext* sim_new(void) {
+    SimContext *sim = g_malloc0(sizeof(SimContext));
+    sim->obstacle_sprites = g_ptr_array_new_with_free_func((GDestroyNotify)g_object_unref);
+    sim->arcade_mode = FALSE; /* default to physics movement */
+    sim->seed = (guint64)g_get_real_time();
+    DifficultyParams params;
+    difficulty_params_defaults(&params);
+    sim->difficulty = difficulty_table_new(&params);
+    sim_reset(sim);
+    return sim;
+}
+
+// Sprites only affect drawing; they are picked up by the next sim_reset
+void sim_set_player_sprite(SimContext *sim, GdkPixbuf *sprite) {
+    if (sprite) g_object_ref(sprite);
+    if (sim->player_sprite) g_object_unref(sim->player_sprite);
+    sim->player_sprite = sprite;
+}
+
+void sim_add_obstacle_sprite(SimContext *sim, GdkPixbuf *sprite) {
+    if (sprite) g_ptr_array_add(sim->obstacle_sprites, g_object_ref(sprite));
+}
+
+void sim_set_arcade_mode(SimContext *sim, gboolean arcade_mode) {
+    sim->arcade_mode = arcade_mode;
+}
+
+// Seed for the next sim_reset; same seed + same inputs => same run
+void sim_set_seed(SimContext *sim, guint64 seed) {
+    sim->seed = seed;
+}
+
+/* Difficulty curve for the next sim_reset (tuning tools sweep these). The
+   table is rebuilt only if the parameters actually change. */
+void sim_set_difficulty(SimContext *sim, const DifficultyParams *params) {
+    if (memcmp(&sim->difficulty->params, params, sizeof(DifficultyParams)) == 0) return;
+    DifficultyTable *table = difficulty_table_new(params);
+    sim_set_difficulty_table(sim, table);
+    difficulty_table_unref(table);
+}
+
+// Share an already built table (one per parameter set across many contexts)
+void sim_set_difficulty_table(SimContext *sim, DifficultyTable *table) {
+    difficulty_table_ref(table);
+    difficulty_table_unref(sim->difficulty);
+    sim->difficulty = table;
+}
+
+// Start a fresh run: new player and obstacles, score and difficulty back to zero
+void sim_reset(SimContext *sim) {
+    sim->game_over = FALSE;
+    sim->tick = 0;
+    sim->score = 0;
+    sim->level = 1;
+    sim->score_accum = 0.0;
+    sim->difficulty_stage = 1;
+    sim->last_stage_shown = 0;
+    sim_update_difficulty(sim);
+
+    if (sim->player) {
+        player_free(sim->player);
+    }
+    sim->player = player_new(GAME_WIDTH / 2 - 25, GAME_HEIGHT - 100, sim->player_sprite);
+
+    ObstacleManager *previous = sim->obstacles;
+    sim->obstacles = obstacle_manager_new();
+    if (previous) {
+        /* The drawing atlas outlives the run; it is rebuilt only for new templates or a new scale */
+        obstacle_manager_take_atlas(sim->obstacles, previous);
+        obstacle_manager_free(previous);
+    }
+    obstacle_manager_seed(sim->obstacles, sim->seed);
+    /* Apply initial exponential difficulty scaling to obstacles */
+    apply_difficulty(sim);
+    for (guint i = 0; i < sim->obstacle_sprites->len; i++) {
+        g_ptr_array_add(sim->obstacles->sprite_templates, g_object_ref(g_ptr_array_index(sim->obstacle_sprites, i)));
+    }
+}
+
+// Update player movement based on held keys
+static void sim_apply_input(SimContext *sim, guint input, gdouble delta_time) {
+    Player *player = sim->player;
+    gboolean moving_left = (input & SIM_INPUT_LEFT) != 0;
+    gboolean moving_right = (input & SIM_INPUT_RIGHT) != 0;
+    gboolean moving_up = (input & SIM_INPUT_UP) != 0;
+    gboolean moving_down = (input & SIM_INPUT_DOWN) != 0;
+
+    // Apply movement each tick based on held keys
+    // Left/Right: turning
+    if (sim->arcade_mode) {
+        /* Arcade movement: direct X/Y movement independent of rotation.
+         * Use a constant speed and normalize diagonal movement so
+         * diagonal speed equals single-axis speed.
+         */
+        const gdouble ARCADE_SPEED = 400.0; /* units per second */
+        gdouble dir_x = 0.0;
+        gdouble dir_y = 0.0;
+        if (moving_left) dir_x -= 1.0;
+        if (moving_right) dir_x += 1.0;
+        if (moving_up) dir_y -= 1.0;    /* screen Y grows downward, so up is -1 */
+        if (moving_down) dir_y += 1.0;
+
+        if (dir_x == 0.0 && dir_y == 0.0) {
+            /* No movement keys: stop immediately for tight arcade feel */
+            player->velocity_x = 0.0;
+            player->velocity_y = 0.0;
+        } else {
+            /* Normalize diagonal movement so magnitude == ARCADE_SPEED */
+            gdouble len = sqrt(dir_x * dir_x + dir_y * dir_y);
+            if (len > 0.0) {
+                dir_x /= len;
+                dir_y /= len;
+            }
+            player->velocity_x = dir_x * ARCADE_SPEED;
+            player->velocity_y = dir_y * ARCADE_SPEED;
+        }
+    } else {
+        /* Physics movement: turning + forward/backward acceleration */
+        if (moving_left) {
+            player_move_left(player, delta_time);
+        }
+        if (moving_right) {
+            player_move_right(player, delta_time);
+        }
+
+        /* Up/Down: acceleration / braking */
+        if (moving_up) {
+            player_move_up(player, delta_time);
+        }
+        if (moving_down) {
+            player_move_down(player, delta_time);
+        }
+    }
+}
+
+static gboolean sim_player_hit(SimContext *sim) {
+    Player *player = sim->player;
+    const ObstaclePool *pool = &sim->obstacles->pool;
+
+    /* The player's inset box is the same for every test this tick */
+    CollisionBox player_box;
+    collision_box_init(&player_box, player->x, player->y, player->width, player->height);
+
+    if (pool->count < BROAD_PHASE_MIN_OBSTACLES) {
+        /* Few obstacles: one SIMD sweep over the contiguous pool beats a grid query */
+        return collision_first_hit(&player_box, pool->x, pool->y, pool->w, pool->h, pool->count) >= 0;
+    }
+
+    /* Broad phase: only obstacles sharing a grid cell with the player reach
+       the inset AABB test */
+    const guint *candidates = NULL;
+    guint n_candidates = obstacle_manager_query_rect(sim->obstacles, player->x, player->y,
+                                                     player->width, player->height, &candidates);
+    for (guint k = 0; k < n_candidates; k++) {
+        guint i = candidates[k];
+        if (collision_box_test(&player_box, pool->x[i], pool->y[i], pool->w[i], pool->h[i])) return TRUE;
+    }
+    return FALSE;
+}
+
+void sim_step(SimContext *sim, guint input, gdouble delta_time) {
+    if (sim->game_over) return;
+
+    /* Snapshot the state we are leaving so rendering can interpolate */
+    player_save_previous_state(sim->player);
+    obstacle_manager_save_previous_state(sim->obstacles);
+    sim->tick++;
+
+    sim_apply_input(sim, input, delta_time);
+
+    // Update player
+    player_update(sim->player, delta_time, GAME_WIDTH, GAME_HEIGHT);
+
+    // Update obstacles
+    obstacle_manager_update(sim->obstacles, delta_time, GAME_HEIGHT);
+
+    // Spawn new obstacles
+    obstacle_manager_spawn(sim->obstacles, delta_time, GAME_WIDTH, GAME_HEIGHT);
+
+    // Collision detection ends the run; the caller decides what to do with the score
+    if (sim_player_hit(sim)) {
+        sim->game_over = TRUE;
+        return;
+    }
+
+    /* EXPONENTIAL DIFFICULTY SYSTEM: Score accumulation with multiplier */
+    sim->score_accum += (SCORE_RATE_BASE * sim->score_multiplier) * delta_time;
+    if (sim->score_accum >= 1.0) {
+        while (sim->score_accum >= 1.0) {
+            sim->score += 1;
+            sim->score_accum -= 1.0;
+        }
+
+        /* Nothing reads the difficulty between the points of one tick, so it
+           is looked up once for the final score and applied to obstacles */
+        sim_update_difficulty(sim);
+        apply_difficulty(sim);
+    }
+
+    /* Announce difficulty stage transitions */
+    if (sim->difficulty_stage != sim->last_stage_shown) {
+        g_debug("DIFFICULTY STAGE %d: %s!", sim->difficulty_stage, sim_stage_name(sim->difficulty_stage));
+        sim->last_stage_shown = sim->difficulty_stage;
+    }
+
+    // Legacy level system (kept for compatibility; exponential difficulty now primary)
+    if (sim->score % 1000 == 0 && sim->score > 0) {
+        sim->level++;
+    }
+}
+
+gboolean sim_is_over(const SimContext *sim) {
+    return sim->game_over;
+}
+
+gint sim_get_score(const SimContext *sim) {
+    return sim->score;
+}
+
+guint64 sim_get_tick(const SimContext *sim) {
+    return sim->tick;
+}
+
+void sim_free(SimContext *sim) {
+    if (!sim) return;
+    player_free(sim->player);
+    obstacle_manager_free(sim->obstacles);
+    if (sim->player_sprite) g_object_unref(sim->player_sprite);
+    g_ptr_array_free(sim->obstacle_sprites, TRUE);
+    difficulty_table_unref(sim->difficulty);
+    g_free(sim);
+}
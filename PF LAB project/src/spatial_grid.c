@@ -0,0 +1,119 @@
+#include "spatial_grid.h"
+#include <math.h>
+#include <string.h>
+
+SpatialGrid* spatial_grid_new(gdouble origin_x, gdouble origin_y, gdouble width, gdouble height, gdouble cell_size) {
+    SpatialGrid *grid = g_malloc0(sizeof(SpatialGrid));
+    grid->origin_x = origin_x;
+    grid->origin_y = origin_y;
+    grid->cell_size = cell_size;
+    grid->cols = MAX(1, (gint)ceil(width / cell_size));
+    grid->rows = MAX(1, (gint)ceil(height / cell_size));
+    guint cells = (guint)(grid->cols * grid->rows);
+    grid->cell_start = g_new0(guint, cells + 1);
+    grid->cell_fill = g_new0(guint, cells);
+    return grid;
+}
+
+static inline gint grid_col(const SpatialGrid *grid, gdouble x) {
+    gint c = (gint)floor((x - grid->origin_x) / grid->cell_size);
+    return CLAMP(c, 0, grid->cols - 1);
+}
+
+static inline gint grid_row(const SpatialGrid *grid, gdouble y) {
+    gint r = (gint)floor((y - grid->origin_y) / grid->cell_size);
+    return CLAMP(r, 0, grid->rows - 1);
+}
+
+void spatial_grid_rebuild(SpatialGrid *grid, const gdouble *x, const gdouble *y,
+                          const gdouble *w, const gdouble *h, guint count) {
+    guint cells = (guint)(grid->cols * grid->rows);
+
+    if (count > grid->box_capacity) {
+        guint capacity = MAX(count, grid->box_capacity * 2);
+        grid->stamp = g_renew(guint, grid->stamp, capacity);
+        grid->results = g_renew(guint, grid->results, capacity);
+        memset(grid->stamp, 0, capacity * sizeof(guint));
+        grid->box_capacity = capacity;
+        grid->query_id = 0;
+    }
+
+    // Pass 1: count how many boxes touch each cell
+    memset(grid->cell_fill, 0, cells * sizeof(guint));
+    guint total = 0;
+    for (guint i = 0; i < count; i++) {
+        gint c0 = grid_col(grid, x[i]), c1 = grid_col(grid, x[i] + w[i]);
+        gint r0 = grid_row(grid, y[i]), r1 = grid_row(grid, y[i] + h[i]);
+        for (gint r = r0; r <= r1; r++) {
+            for (gint c = c0; c <= c1; c++) {
+                grid->cell_fill[r * grid->cols + c]++;
+            }
+        }
+        total += (guint)((r1 - r0 + 1) * (c1 - c0 + 1));
+    }
+
+    if (total > grid->item_capacity) {
+        grid->item_capacity = MAX(total, grid->item_capacity * 2);
+        grid->items = g_renew(guint, grid->items, grid->item_capacity);
+    }
+
+    // Prefix sum into cell_start; cell_fill becomes the write cursor
+    guint offset = 0;
+    for (guint cell = 0; cell < cells; cell++) {
+        grid->cell_start[cell] = offset;
+        offset += grid->cell_fill[cell];
+        grid->cell_fill[cell] = grid->cell_start[cell];
+    }
+    grid->cell_start[cells] = offset;
+
+    // Pass 2: scatter box indices into their cells
+    for (guint i = 0; i < count; i++) {
+        gint c0 = grid_col(grid, x[i]), c1 = grid_col(grid, x[i] + w[i]);
+        gint r0 = grid_row(grid, y[i]), r1 = grid_row(grid, y[i] + h[i]);
+        for (gint r = r0; r <= r1; r++) {
+            for (gint c = c0; c <= c1; c++) {
+                grid->items[grid->cell_fill[r * grid->cols + c]++] = i;
+            }
+        }
+    }
+}
+
+/* Collect every box sharing a cell with the rectangle (edges inclusive).
+   Results are unique and stay valid until the next query or rebuild. */
+guint spatial_grid_query(SpatialGrid *grid, gdouble x, gdouble y, gdouble w, gdouble h, const guint **results) {
+    gint c0 = grid_col(grid, x), c1 = grid_col(grid, x + w);
+    gint r0 = grid_row(grid, y), r1 = grid_row(grid, y + h);
+    guint found = 0;
+
+    if (++grid->query_id == 0) {
+        /* Stamp counter wrapped: clear so stale stamps cannot match */
+        memset(grid->stamp, 0, grid->box_capacity * sizeof(guint));
+        grid->query_id = 1;
+    }
+
+    for (gint r = r0; r <= r1; r++) {
+        for (gint c = c0; c <= c1; c++) {
+            gint cell = r * grid->cols + c;
+            for (guint k = grid->cell_start[cell]; k < grid->cell_start[cell + 1]; k++) {
+                guint i = grid->items[k];
+                if (grid->stamp[i] != grid->query_id) {
+                    grid->stamp[i] = grid->query_id;
+                    grid->results[found++] = i;
+                }
+            }
+        }
+    }
+
+    if (results) *results = grid->results;
+    return found;
+}
+
+void spatial_grid_free(SpatialGrid *grid) {
+    if (!grid) return;
+    g_free(grid->cell_start);
+    g_free(grid->cell_fill);
+    g_free(grid->items);
+    g_free(grid->stamp);
+    g_free(grid->results);
+    g_free(grid);
+}
@@ -0,0 +1,126 @@
+#include "trace.h"
+#include <string.h>
+
+typedef struct {
+    const gchar *name;
+    gint64 start_us;
+    gint64 duration_us;
+} TraceEvent;
+
+/* One per thread that ever recorded an event. The owner is the only writer;
+   the lock is only contended while trace_flush copies the ring out. */
+typedef struct {
+    GMutex lock;
+    guint tid;
+    gboolean main_thread;   // recorded on the thread that called trace_enable
+    guint64 written;        // events ever recorded; slot = written % TRACE_EVENTS_PER_THREAD
+    TraceEvent *events;
+} TraceBuffer;
+
+volatile gint trace_active = 0;
+
+static GMutex registry_lock;
+static GPtrArray *buffers = NULL;   // every TraceBuffer, never freed before trace_shutdown
+static gchar *trace_path = NULL;
+static gint64 trace_epoch_us = 0;
+static guint next_tid = 1;
+static GThread *main_thread = NULL; // the thread that called trace_enable
+static GPrivate thread_buffer;      // this thread's TraceBuffer
+
+/* Start collecting; trace_flush (hotkey, exit) writes everything collected so
+   far to path. Call it from the main thread: that thread is labelled "main". */
+void trace_enable(const gchar *path) {
+    g_mutex_lock(&registry_lock);
+    if (!main_thread) main_thread = g_thread_self();
+    g_free(trace_path);
+    trace_path = g_strdup(path);
+    if (!buffers) buffers = g_ptr_array_new();
+    if (trace_epoch_us == 0) trace_epoch_us = g_get_monotonic_time();
+    g_mutex_unlock(&registry_lock);
+    g_atomic_int_set(&trace_active, 1);
+}
+
+gboolean trace_is_enabled(void) {
+    return g_atomic_int_get(&trace_active) != 0;
+}
+
+static TraceBuffer* trace_thread_buffer(void) {
+    TraceBuffer *buffer = g_private_get(&thread_buffer);
+    if (buffer) return buffer;
+
+    buffer = g_malloc0(sizeof(TraceBuffer));
+    g_mutex_init(&buffer->lock);
+    buffer->events = g_new(TraceEvent, TRACE_EVENTS_PER_THREAD);
+    g_mutex_lock(&registry_lock);
+    buffer->tid = next_tid++;
+    buffer->main_thread = g_thread_self() == main_thread;
+    g_ptr_array_add(buffers, buffer);
+    g_mutex_unlock(&registry_lock);
+    g_private_set(&thread_buffer, buffer);
+    return buffer;
+}
+
+void trace_record(const gchar *name, gint64 start_us, gint64 end_us) {
+    TraceBuffer *buffer = trace_thread_buffer();
+    g_mutex_lock(&buffer->lock);
+    TraceEvent *event = &buffer->events[buffer->written & (TRACE_EVENTS_PER_THREAD - 1)];
+    event->name = name;
+    event->start_us = start_us;
+    event->duration_us = end_us - start_us;
+    buffer->written++;
+    g_mutex_unlock(&buffer->lock);
+}
+
+/* Write every buffered event as complete ("X") events, one tid per thread, in
+   the Chrome trace-event format; tracing keeps running afterwards */
+gboolean trace_flush(GError **error) {
+    if (!trace_is_enabled()) return TRUE;
+
+    GString *json = g_string_new("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    gboolean first = TRUE;
+    g_mutex_lock(&registry_lock);
+    for (guint b = 0; b < buffers->len; b++) {
+        TraceBuffer *buffer = g_ptr_array_index(buffers, b);
+        gchar *thread_name = buffer->main_thread ? g_strdup("main") : g_strdup_printf("thread %u", buffer->tid);
+        g_string_append_printf(json, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %u, "
+                               "\"args\": {\"name\": \"%s\"}}",
+                               first ? "" : ",\n", buffer->tid, thread_name);
+        g_free(thread_name);
+        first = FALSE;
+
+        g_mutex_lock(&buffer->lock);
+        guint64 count = MIN(buffer->written, TRACE_EVENTS_PER_THREAD);
+        for (guint64 i = buffer->written - count; i < buffer->written; i++) {
+            const TraceEvent *event = &buffer->events[i & (TRACE_EVENTS_PER_THREAD - 1)];
+            g_string_append_printf(json, ",\n{\"name\": \"%s\", \"cat\": \"game\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, "
+                                   "\"ts\": %" G_GINT64_FORMAT ", \"dur\": %" G_GINT64_FORMAT "}",
+                                   event->name, buffer->tid, event->start_us - trace_epoch_us, event->duration_us);
+        }
+        g_mutex_unlock(&buffer->lock);
+    }
+    gchar *path = g_strdup(trace_path);
+    g_mutex_unlock(&registry_lock);
+    g_string_append(json, "\n]}\n");
+
+    gboolean ok = g_file_set_contents(path, json->str, json->len, error);
+    g_string_free(json, TRUE);
+    g_free(path);
+    return ok;
+}
+
+// Stop tracing and free the buffers; once, at exit, after every other thread is done
+void trace_shutdown(void) {
+    g_atomic_int_set(&trace_active, 0);
+    g_mutex_lock(&registry_lock);
+    for (guint b = 0; buffers && b < buffers->len; b++) {
+        TraceBuffer *buffer = g_ptr_array_index(buffers, b);
+        g_mutex_clear(&buffer->lock);
+        g_free(buffer->events);
+        g_free(buffer);
+    }
+    if (buffers) g_ptr_array_free(buffers, TRUE);
+    buffers = NULL;
+    g_free(trace_path);
+    trace_path = NULL;
+    g_mutex_unlock(&registry_lock);
+}
@@ -0,0 +1,120 @@
+#include "work_pool.h"
+
+/* One worker's slice [next, end). The owner pops from the front, thieves
+   split off the back half; both sides hold the lock, which is uncontended
+   except while a steal is in progress. Padded so neighbouring slices do not
+   share a cache line. */
+typedef struct {
+    GMutex lock;
+    guint next;
+    guint end;
+    guint8 pad[64];
+} WorkSlice;
+
+typedef struct {
+    WorkSlice *slices;
+    guint n_workers;
+    WorkPoolFunc func;
+    gpointer user_data;
+} WorkPool;
+
+typedef struct {
+    WorkPool *pool;
+    guint id;
+} WorkerArgs;
+
+guint work_pool_default_workers(void) {
+    return MAX(1, g_get_num_processors());
+}
+
+static gboolean slice_pop(WorkSlice *slice, guint *index) {
+    gboolean found = FALSE;
+    g_mutex_lock(&slice->lock);
+    if (slice->next < slice->end) {
+        *index = slice->next++;
+        found = TRUE;
+    }
+    g_mutex_unlock(&slice->lock);
+    return found;
+}
+
+// Move the back half of the fullest other slice into ours; FALSE when all are empty
+static gboolean steal(WorkPool *pool, guint thief) {
+    for (;;) {
+        guint victim = thief;
+        guint most = 0;
+        for (guint w = 0; w < pool->n_workers; w++) {
+            if (w == thief) continue;
+            guint left = g_atomic_int_get((volatile gint *)&pool->slices[w].end) -
+                         g_atomic_int_get((volatile gint *)&pool->slices[w].next);
+            if ((gint)left > (gint)most) {
+                most = left;
+                victim = w;
+            }
+        }
+        if (victim == thief) return FALSE;
+
+        WorkSlice *from = &pool->slices[victim];
+        guint begin = 0, end = 0;
+        g_mutex_lock(&from->lock);
+        if (from->next < from->end) {
+            guint take = (from->end - from->next + 1) / 2;
+            end = from->end;
+            begin = end - take;
+            from->end = begin;
+        }
+        g_mutex_unlock(&from->lock);
+        if (begin == end) continue; /* victim drained meanwhile: rescan */
+
+        WorkSlice *to = &pool->slices[thief];
+        g_mutex_lock(&to->lock);
+        to->next = begin;
+        to->end = end;
+        g_mutex_unlock(&to->lock);
+        return TRUE;
+    }
+}
+
+static gpointer worker_main(gpointer data) {
+    WorkerArgs *args = data;
+    WorkPool *pool = args->pool;
+    guint index;
+    do {
+        while (slice_pop(&pool->slices[args->id], &index)) {
+            pool->func(index, args->id, pool->user_data);
+        }
+    } while (steal(pool, args->id));
+    return NULL;
+}
+
+// Run func(index, worker, user_data) for every index in [0, n_items); returns when all are done
+void work_pool_run(guint n_items, guint n_workers, WorkPoolFunc func, gpointer user_data) {
+    if (n_workers == 0) n_workers = work_pool_default_workers();
+    n_workers = MIN(n_workers, MAX(n_items, 1));
+
+    WorkPool pool = {g_new0(WorkSlice, n_workers), n_workers, func, user_data};
+    WorkerArgs *args = g_new(WorkerArgs, n_workers);
+    GThread **threads = g_new0(GThread *, n_workers);
+
+    for (guint w = 0; w < n_workers; w++) {
+        g_mutex_init(&pool.slices[w].lock);
+        pool.slices[w].next = (guint)((guint64)n_items * w / n_workers);
+        pool.slices[w].end = (guint)((guint64)n_items * (w + 1) / n_workers);
+        args[w].pool = &pool;
+        args[w].id = w;
+    }
+    for (guint w = 1; w < n_workers; w++) {
+        threads[w] = g_thread_new("work-pool", worker_main, &args[w]);
+    }
+    worker_main(&args[0]);
+    for (guint w = 1; w < n_workers; w++) {
+        g_thread_join(threads[w]);
+    }
+
+    for (guint w = 0; w < n_workers; w++) {
+        g_mutex_clear(&pool.slices[w].lock);
+    }
+    g_free(threads);
+    g_free(args);
+    g_free(pool.slices);
+}